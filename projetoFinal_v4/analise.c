@@ -0,0 +1,403 @@
+/** \file analise.c
+ * \brief   Funes de anlise de escalonabilidade.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <math.h>
+
+#include "analise.h"
+
+VEREDITO analise_utilizacao(lista_enc_t* listaTarefas, double* utilizacao)
+{
+    tarefa_t* p_tarefa;
+    no_t* p_no;
+    double d, total, densidade, produto;
+    int n;
+
+    if (listaTarefas == NULL) {
+        fprintf(stderr, "analise_utilizacao: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    total = 0;
+    densidade = 0;
+    produto = 1;
+    n = 0;
+
+    for(p_no = obter_cabeca(listaTarefas); p_no; p_no = obtem_proximo(p_no)){
+        p_tarefa = (tarefa_t*) obter_dado(p_no);
+        total += (double) tarefa_get_duracao(p_tarefa)/tarefa_get_periodo(p_tarefa);
+        d = (double) tarefa_get_duracao(p_tarefa)/tarefa_get_prazo(p_tarefa);
+        densidade += d;
+        produto *= d + 1;
+        n++;
+    }
+
+    if(utilizacao){
+        *utilizacao = total;
+    }
+
+    if(total > 1 + ANALISE_TOLERANCIA){
+        return NAO_ESCALONAVEL;
+    }
+    // Com prazo menor que o perodo os limites valem para a densidade Ci/Di
+    if(n == 0 || densidade <= n*(pow(2, 1.0/n) - 1) - ANALISE_TOLERANCIA){
+        return ESCALONAVEL;
+    }
+    if(produto <= 2 - ANALISE_TOLERANCIA){
+        return ESCALONAVEL;
+    }
+
+    return INCONCLUSIVO;
+}
+
+VEREDITO analise_utilizacao_edf(lista_enc_t* listaTarefas, double* utilizacao)
+{
+    tarefa_t* p_tarefa;
+    no_t* p_no;
+    double total, densidade;
+
+    if (listaTarefas == NULL) {
+        fprintf(stderr, "analise_utilizacao_edf: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    total = 0;
+    densidade = 0;
+
+    for(p_no = obter_cabeca(listaTarefas); p_no; p_no = obtem_proximo(p_no)){
+        p_tarefa = (tarefa_t*) obter_dado(p_no);
+        total += (double) tarefa_get_duracao(p_tarefa)/tarefa_get_periodo(p_tarefa);
+        densidade += (double) tarefa_get_duracao(p_tarefa)/tarefa_get_prazo(p_tarefa);
+    }
+
+    if(utilizacao){
+        *utilizacao = total;
+    }
+
+    if(total > 1 + ANALISE_TOLERANCIA){
+        return NAO_ESCALONAVEL;
+    }
+    if(densidade <= 1 + ANALISE_TOLERANCIA && densidade == total){     // Prazo igual ao perodo: U <= 1  exato
+        return ESCALONAVEL;
+    }
+    if(densidade <= 1 - ANALISE_TOLERANCIA){
+        return ESCALONAVEL;
+    }
+
+    return INCONCLUSIVO;
+}
+
+VEREDITO analise_global(lista_enc_t* listaTarefas, int nucleos, const politica_t* politica, double* utilizacao)
+{
+    tarefa_t* p_tarefa;
+    no_t* p_no;
+    double d, total, densidade, maior;
+
+    if (listaTarefas == NULL || politica == NULL || nucleos < 1) {
+        fprintf(stderr, "analise_global: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    total = 0;
+    densidade = 0;
+    maior = 0;
+
+    for(p_no = obter_cabeca(listaTarefas); p_no; p_no = obtem_proximo(p_no)){
+        p_tarefa = (tarefa_t*) obter_dado(p_no);
+        total += (double) tarefa_get_duracao(p_tarefa)/tarefa_get_periodo(p_tarefa);
+        d = (double) tarefa_get_duracao(p_tarefa)/tarefa_get_prazo(p_tarefa);
+        densidade += d;
+        if(d > maior){
+            maior = d;
+        }
+    }
+
+    if(utilizacao){
+        *utilizacao = total;
+    }
+
+    // Um "job" no executa em dois ncleos ao mesmo tempo: C > D perde o prazo em qualquer nmero de ncleos
+    if(total > nucleos + ANALISE_TOLERANCIA || maior > 1 + ANALISE_TOLERANCIA){
+        return NAO_ESCALONAVEL;
+    }
+    if(politica == &politica_edf){
+        // Goossens, Funk & Baruah: soma <= m - (m - 1)*maior
+        if(densidade <= nucleos - (nucleos - 1)*maior - ANALISE_TOLERANCIA){
+            return ESCALONAVEL;
+        }
+    }else{
+        // Bertogna, Cirinei & Lipari: soma <= m/2*(1 - maior) + maior
+        if(densidade <= nucleos/2.0*(1 - maior) + maior - ANALISE_TOLERANCIA){
+            return ESCALONAVEL;
+        }
+    }
+
+    return INCONCLUSIVO;
+}
+
+int analise_rta(tabela_t* tabela, uint64_t* resposta)
+{
+    uint64_t r, novo, prazo;
+    int i, j, perdas;
+
+    if (tabela == NULL || resposta == NULL) {
+        fprintf(stderr, "analise_rta: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    perdas = 0;
+
+    for(i = 0; i < tabela->n; i++){
+        prazo = tabela->prazo[i];
+
+        // Ponto de partida: todas as tarefas mais prioritrias executam uma vez
+        r = tabela->duracao[i];
+        for(j = 0; j < i; j++){
+            r += tabela->duracao[j];
+        }
+
+        while(r <= prazo){
+            novo = tabela->duracao[i];
+            for(j = 0; j < i && novo <= prazo; j++){
+                novo += ((r + tabela->periodo[j] - 1)/tabela->periodo[j])*tabela->duracao[j];
+            }
+            if(novo == r){
+                break;
+            }
+            r = novo;
+        }
+
+        if(r > prazo){
+            resposta[i] = ANALISE_INFINITO;
+            perdas++;
+        }else{
+            resposta[i] = r;
+        }
+    }
+
+    return perdas;
+}
+
+// Demanda de processador dos "jobs" com chegada e prazo em [0, t], saturada em ANALISE_INFINITO
+static uint64_t demanda(tabela_t* tabela, uint64_t t)
+{
+    unsigned __int128 h;
+    uint64_t prazo;
+    int i;
+
+    h = 0;
+    for(i = 0; i < tabela->n; i++){
+        prazo = tabela->prazo[i];
+        if(prazo <= t){
+            h += (unsigned __int128) ((t - prazo)/tabela->periodo[i] + 1)*tabela->duracao[i];
+            if(h >= ANALISE_INFINITO){
+                return ANALISE_INFINITO;
+            }
+        }
+    }
+
+    return (uint64_t) h;
+}
+
+// Maior prazo absoluto estritamente anterior a t, 0 caso no exista
+static uint64_t prazo_anterior(tabela_t* tabela, uint64_t t)
+{
+    uint64_t prazo, d, maior;
+    int i;
+
+    maior = 0;
+    for(i = 0; i < tabela->n; i++){
+        prazo = tabela->prazo[i];
+        if(prazo < t){
+            d = (t - prazo - 1)/tabela->periodo[i]*tabela->periodo[i] + prazo;
+            if(d > maior){
+                maior = d;
+            }
+        }
+    }
+
+    return maior;
+}
+
+VEREDITO analise_qpa(tabela_t* tabela, uint64_t* instante)
+{
+    unsigned __int128 w;
+    uint64_t l, limite, novo, t, h, prazo, prazoMinimo, prazoMaximo;
+    double u, folga;
+    int i, implicito;
+
+    if (tabela == NULL) {
+        fprintf(stderr, "analise_qpa: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if(instante){
+        *instante = 0;
+    }
+    if(tabela->n == 0){
+        return ESCALONAVEL;
+    }
+
+    u = 0;
+    folga = 0;
+    implicito = 1;
+    prazoMinimo = ANALISE_INFINITO;
+    prazoMaximo = 0;
+    for(i = 0; i < tabela->n; i++){
+        prazo = tabela->prazo[i];
+        u += (double) tabela->duracao[i]/tabela->periodo[i];
+        if(prazo < tabela->periodo[i]){
+            implicito = 0;
+            folga += (double) (tabela->periodo[i] - prazo)*tabela->duracao[i]/tabela->periodo[i];
+        }
+        if(prazo < prazoMinimo) prazoMinimo = prazo;
+        if(prazo > prazoMaximo) prazoMaximo = prazo;
+    }
+
+    if(u > 1 + ANALISE_TOLERANCIA){
+        return NAO_ESCALONAVEL;
+    }
+    if(implicito){                      // Prazo igual ao perodo: U <= 1  exato
+        return ESCALONAVEL;
+    }
+
+    // Limite de Baruah et al., vlido somente com U < 1
+    limite = ANALISE_INFINITO;
+    if(u < 1 - ANALISE_TOLERANCIA && folga/(1 - u) < (double) ANALISE_INFINITO){
+        limite = (uint64_t) ceil(folga/(1 - u));
+        if(limite < prazoMaximo){
+            limite = prazoMaximo;
+        }
+    }
+
+    // Perodo ocupado sncrono: w = soma(teto(w/Ti)*Ci), interrompido ao passar do limite
+    l = 0;
+    for(i = 0; i < tabela->n; i++){
+        l += tabela->duracao[i];
+    }
+    while(l < limite){
+        w = 0;
+        for(i = 0; i < tabela->n && w < limite; i++){
+            w += (unsigned __int128) ((l + tabela->periodo[i] - 1)/tabela->periodo[i])*tabela->duracao[i];
+        }
+        novo = w < limite ? (uint64_t) w : limite;
+        if(novo == l){
+            break;
+        }
+        l = novo;
+    }
+    if(l > limite){
+        l = limite;
+    }
+
+    // QPA: desce pelos prazos a partir do ltimo antes de L
+    t = prazo_anterior(tabela, l);
+    h = demanda(tabela, t);
+    while(h <= t && h > prazoMinimo){
+        if(h < t){
+            t = h;
+        }else{
+            t = prazo_anterior(tabela, t);
+        }
+        h = demanda(tabela, t);
+    }
+
+    if(h <= prazoMinimo){
+        if(instante){
+            *instante = l;
+        }
+        return ESCALONAVEL;
+    }
+
+    if(instante){
+        *instante = t;
+    }
+    return NAO_ESCALONAVEL;
+}
+
+void analise_imprime(FILE *fp, tabela_t* tabela, uint64_t* resposta)
+{
+    int fases, i;
+
+    if (fp == NULL || tabela == NULL || resposta == NULL) {
+        fprintf(stderr, "analise_imprime: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fases = 0;
+    for(i = 0; i < tabela->n; i++){
+        if(tabela->fase[i]){
+            fases = 1;
+        }
+    }
+
+    for(i = 0; i < tabela->n; i++){
+        fprintf(fp, "T%" PRIu32 "\tC: %" PRIu64 "\tT: %" PRIu64 "\tD: %" PRIu64 "\t", tabela->id[i], tabela->duracao[i],
+                tabela->periodo[i], tabela->prazo[i]);
+        if(resposta[i] == ANALISE_INFINITO){
+            fprintf(fp, fases ? "R: -\tinconclusivo\n" : "R: -\tNAO escalonavel\n");
+        }else{
+            fprintf(fp, "R: %" PRIu64 "\tescalonavel\n", resposta[i]);
+        }
+    }
+}
+
+VEREDITO analise_exata(lista_enc_t* listaTarefas, const politica_t* politica, FILE *fp)
+{
+    tabela_t* tabela;
+    uint64_t* resposta;
+    uint64_t instante;
+    VEREDITO veredito;
+
+    if (listaTarefas == NULL || politica == NULL) {
+        fprintf(stderr, "analise_exata: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if(politica == &politica_edf){
+        tabela = cria_tabela(listaTarefas);
+        veredito = analise_qpa(tabela, &instante);
+        if(fp){
+            fprintf(fp, "\nAnalise de demanda de processador (EDF):\n");
+            if(veredito == ESCALONAVEL){
+                fprintf(fp, "Demanda verificada ate t = %" PRIu64 "\n", instante);
+            }else{
+                fprintf(fp, "Demanda excede o tempo disponivel em t = %" PRIu64 "\n", instante);
+            }
+        }
+    }else{
+        ordena_tarefas(listaTarefas);               // A RTA depende da ordem de prioridade
+        tabela = cria_tabela(listaTarefas);
+        resposta = malloc(((size_t) tabela->n + 1)*sizeof(uint64_t));
+        if(resposta == NULL){
+            perror("analise_exata:");
+            exit(EXIT_FAILURE);
+        }
+        veredito = analise_rta(tabela, resposta) ? NAO_ESCALONAVEL : ESCALONAVEL;
+        if(fp){
+            fprintf(fp, "\nAnalise de tempo de resposta (RM/DM):\n");
+            analise_imprime(fp, tabela, resposta);
+        }
+        free(resposta);
+    }
+    desaloca_tabela(tabela);
+
+    // Os testes supem a chegada sncrona, o pior caso: com fases eles so somente suficientes
+    if(veredito == NAO_ESCALONAVEL && tarefas_maior_fase(listaTarefas)){
+        if(fp){
+            fprintf(fp, "Com fases a chegada sincrona pode nao ocorrer: o teste e somente suficiente.\n");
+        }
+        veredito = INCONCLUSIVO;
+    }
+
+    return veredito;
+}
@@ -0,0 +1,128 @@
+/** \file analise.h
+ * \brief   Cabealho de funes de anlise de escalonabilidade.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#ifndef ANALISE_H_INCLUDED
+#define ANALISE_H_INCLUDED
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "tabela.h"
+
+#define ANALISE_INFINITO    UINT64_MAX  ///< Tempo de resposta de uma tarefa que perde o prazo
+#define ANALISE_TOLERANCIA  1e-9        ///< Margem dos testes em ponto flutuante, sempre a favor do inconclusivo
+
+/** \enum VEREDITO
+ * Resultado de um teste de escalonabilidade, sendo:
+ */
+typedef enum{
+    ESCALONAVEL,        ///< O conjunto certamente  escalonvel
+    NAO_ESCALONAVEL,    ///< O conjunto certamente no  escalonvel
+    INCONCLUSIVO        ///< O teste no decide,  preciso um teste exato
+} VEREDITO;
+
+/// \brief Teste rpido de escalonabilidade por utilizao, para prioridade fixa (RM/DM).
+/**
+ *  \param listaTarefas: ponteiro da lista de tarefas, em qualquer ordem
+ *  \param utilizacao: recebe a utilizao total do conjunto, pode ser NULL
+ *  \return veredito do teste
+ *  \sa analise_rta()
+ *
+ * Em O(n): U > 1 no  escalonvel; U <= n(2^(1/n) - 1) (Liu & Layland) ou
+ * produto(Ui + 1) <= 2 (limite hiperblico)  escalonvel; fora disso  inconclusivo.
+ * Com prazo menor que o perodo os dois limites so aplicados  densidade Ci/Di.
+ */
+VEREDITO analise_utilizacao(lista_enc_t* listaTarefas, double* utilizacao);
+
+/// \brief Teste rpido de escalonabilidade por utilizao, para EDF.
+/**
+ *  \param listaTarefas: ponteiro da lista de tarefas, em qualquer ordem
+ *  \param utilizacao: recebe a utilizao total do conjunto, pode ser NULL
+ *  \return veredito do teste
+ *  \sa analise_qpa()
+ *
+ * U > 1 no  escalonvel; com prazo igual ao perodo U <= 1  escalonvel e o teste  exato.
+ * Com prazos menores, densidade soma(Ci/Di) <= 1  escalonvel e fora disso  inconclusivo.
+ */
+VEREDITO analise_utilizacao_edf(lista_enc_t* listaTarefas, double* utilizacao);
+
+/// \brief Teste rpido de escalonabilidade por densidade para o escalonamento global em m ncleos.
+/**
+ *  \param listaTarefas: ponteiro da lista de tarefas, em qualquer ordem
+ *  \param nucleos: nmero de ncleos idnticos
+ *  \param politica: politica_rm (prioridade fixa, RM/DM) ou politica_edf
+ *  \param utilizacao: recebe a utilizao total do conjunto, pode ser NULL
+ *  \return veredito do teste
+ *  \sa analise_utilizacao(), escalonador_simula_global()
+ *
+ * U > m ou alguma tarefa com Ci > Di no  escalonvel. Com densidade total soma(Ci/Di) e maior
+ * densidade dmax, EDF global  escalonvel se soma <= m - (m - 1)*dmax (Goossens, Funk & Baruah) e
+ * prioridade fixa global (DM) se soma <= m/2*(1 - dmax) + dmax (Bertogna, Cirinei & Lipari).
+ * Fora disso  inconclusivo: no h teste exato, e a simulao sncrona no  o pior caso global.
+ */
+VEREDITO analise_global(lista_enc_t* listaTarefas, int nucleos, const politica_t* politica, double* utilizacao);
+
+/// \brief Calcula o tempo de resposta de pior caso de cada tarefa (Response Time Analysis).
+/**
+ *  \param tabela: tabela de tarefas, o ndice de cada tarefa  sua prioridade (0  a maior)
+ *  \param resposta: vetor com tabela->n posies que recebe o tempo de resposta de cada tarefa
+ *  \return nmero de tarefas que perdem o prazo
+ *  \sa cria_tabela(), ordena_tarefas(), analise_imprime()
+ *
+ * Iterao de ponto fixo R = C + soma(teto(R/Tj)*Cj) sobre as tarefas mais prioritrias,
+ * com prazo (D) no mximo igual ao perodo. A iterao  interrompida quando R passa do prazo,
+ * e nesse caso a resposta  ANALISE_INFINITO.
+ */
+int analise_rta(tabela_t* tabela, uint64_t* resposta);
+
+/// \brief Teste exato de escalonabilidade para EDF por demanda de processador (QPA).
+/**
+ *  \param tabela: tabela de tarefas, em qualquer ordem
+ *  \param instante: recebe o fim do intervalo verificado, se escalonvel, ou o prazo em que a
+ *                   demanda excede o tempo disponvel, se no escalonvel; pode ser NULL
+ *  \return ESCALONAVEL ou NAO_ESCALONAVEL
+ *  \sa analise_utilizacao()
+ *
+ * A demanda h(t) = soma((piso((t - Di)/Ti) + 1)*Ci), para Di <= t, no pode passar de t em nenhum
+ * prazo absoluto anterior a L, o menor entre o perodo ocupado sncrono e o limite de
+ * Baruah et al. Em vez de visitar todos os prazos, o QPA (Zhang & Burns) parte do ltimo
+ * prazo antes de L e salta para h(t) enquanto h(t) < t, o que costuma exigir poucas iteraes.
+ * Com prazo igual ao perodo o teste se reduz a U <= 1.
+ */
+VEREDITO analise_qpa(tabela_t* tabela, uint64_t* instante);
+
+/// \brief Escreve o resultado da anlise de tempo de resposta, uma linha por tarefa.
+/**
+ *  \param fp: arquivo de sada
+ *  \param tabela: tabela de tarefas analisada
+ *  \param resposta: tempos de resposta calculados por analise_rta()
+ *  \return vazio
+ *  \sa analise_rta()
+ *
+ * A anlise supe a chegada sncrona de todas as tarefas. Com fases esse instante pode nunca
+ * ocorrer, e uma tarefa sem tempo de resposta limitado  inconclusiva em vez de no escalonvel.
+ */
+void analise_imprime(FILE *fp, tabela_t* tabela, uint64_t* resposta);
+
+/// \brief Teste exato de um ncleo: QPA para EDF e RTA para prioridade fixa.
+/**
+ *  \param listaTarefas: ponteiro da lista de tarefas; com prioridade fixa ela  ordenada por prioridade
+ *  \param politica: politica_rm (prioridade fixa, RM/DM) ou politica_edf
+ *  \param fp: recebe o relatrio do teste - instante da demanda ou tempo de resposta de cada tarefa -,
+ *             pode ser NULL
+ *  \return veredito do teste
+ *  \sa analise_qpa(), analise_rta(), analise_imprime()
+ *
+ * Para quando o teste de utilizao  inconclusivo. Os dois testes supem a chegada sncrona; com
+ * fases ela pode nunca ocorrer, e NAO_ESCALONAVEL passa a INCONCLUSIVO.
+ */
+VEREDITO analise_exata(lista_enc_t* listaTarefas, const politica_t* politica, FILE *fp);
+
+#endif // ANALISE_H_INCLUDED
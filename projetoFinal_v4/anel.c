@@ -0,0 +1,109 @@
+/** \file anel.c
+ * \brief   Anel de eventos sem travas, um produtor e um consumidor (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "anel.h"
+
+#define LINHA_CACHE     64
+
+/* Os ndices crescem sem limite e so reduzidos pela mscara no acesso; cada lado guarda uma
+ * cpia do ndice do outro e s rel o atmico quando a cpia indica anel cheio ou vazio. */
+struct aneis {
+    _Alignas(LINHA_CACHE) atomic_size_t fim;    // Prxima posio a escrever, escrito pelo produtor
+    size_t inicioCache;                         // ltima leitura de inicio feita pelo produtor
+
+    _Alignas(LINHA_CACHE) atomic_size_t inicio; // Prxima posio a ler, escrito pelo consumidor
+    size_t fimCache;                            // ltima leitura de fim feita pelo consumidor
+
+    _Alignas(LINHA_CACHE) size_t mascara;
+    evento_t *eventos;
+    void *memoria;                              // Bloco alocado, do qual o anel  a parte alinhada
+};
+
+anel_t *cria_anel(size_t capacidade)
+{
+    anel_t *p;
+    void *memoria;
+    size_t tamanho;
+
+    tamanho = 2;
+    while (tamanho < capacidade)
+        tamanho <<= 1;
+
+    // Alinhado  mo, como na tabela: malloc s garante o alinhamento dos tipos bsicos
+    memoria = malloc(sizeof(anel_t) + LINHA_CACHE);
+    if (memoria == NULL){
+        perror("cria_anel:");
+        exit(EXIT_FAILURE);
+    }
+    p = (anel_t*) (((uintptr_t) memoria + LINHA_CACHE - 1) & ~((uintptr_t) LINHA_CACHE - 1));
+    p->memoria = memoria;
+
+    p->eventos = malloc(tamanho * sizeof(evento_t));
+    if (p->eventos == NULL){
+        perror("cria_anel:");
+        exit(EXIT_FAILURE);
+    }
+
+    atomic_init(&p->fim, 0);
+    atomic_init(&p->inicio, 0);
+    p->inicioCache = 0;
+    p->fimCache = 0;
+    p->mascara = tamanho - 1;
+
+    return p;
+}
+
+void desaloca_anel(anel_t *anel)
+{
+    if (anel == NULL){
+        fprintf(stderr,"desaloca_anel: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    free(anel->eventos);
+    free(anel->memoria);
+}
+
+int anel_insere(anel_t *anel, const evento_t *evento)
+{
+    size_t fim = atomic_load_explicit(&anel->fim, memory_order_relaxed);
+
+    if (fim - anel->inicioCache > anel->mascara){
+        anel->inicioCache = atomic_load_explicit(&anel->inicio, memory_order_acquire);
+        if (fim - anel->inicioCache > anel->mascara)
+            return 0;                                   // Cheio
+    }
+
+    anel->eventos[fim & anel->mascara] = *evento;
+    atomic_store_explicit(&anel->fim, fim + 1, memory_order_release);
+
+    return 1;
+}
+
+int anel_retira(anel_t *anel, evento_t *evento)
+{
+    size_t inicio = atomic_load_explicit(&anel->inicio, memory_order_relaxed);
+
+    if (inicio == anel->fimCache){
+        anel->fimCache = atomic_load_explicit(&anel->fim, memory_order_acquire);
+        if (inicio == anel->fimCache)
+            return 0;                                   // Vazio
+    }
+
+    *evento = anel->eventos[inicio & anel->mascara];
+    atomic_store_explicit(&anel->inicio, inicio + 1, memory_order_release);
+
+    return 1;
+}
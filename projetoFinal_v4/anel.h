@@ -0,0 +1,53 @@
+/** \file anel.h
+ * \brief   Cabealho do anel de eventos sem travas, um produtor e um consumidor (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ * Buffer circular de capacidade fixa (potncia de 2) entre exatamente duas threads: uma s
+ * insere e a outra s retira. A sincronizao  feita apenas com os ndices de incio e fim,
+ * atmicos e em linhas de cache separadas; nenhuma funo bloqueia. Cheio ou vazio, quem chama
+ * decide se espera.
+ */
+
+#ifndef ANEL_H_INCLUDED
+#define ANEL_H_INCLUDED
+
+#include <stddef.h>
+#include <inttypes.h>
+
+/** \enum TIPO_EVENTO
+ * Eventos do Diagrama de Gannt trocados pelo anel, sendo:
+ */
+typedef enum{
+    EVENTO_CHEGADA,     ///< Chegada de um "job" - seta para cima
+    EVENTO_EXECUCAO,    ///< Trecho de execuo de inicio a fim
+    EVENTO_TERMINO,     ///< Trmino de um "job" - seta para baixo
+    EVENTO_FIM          ///< No h mais eventos
+} TIPO_EVENTO;
+
+/** \struct evento anel.h "anel.h"
+ *   \brief Evento binrio compacto, formatado como texto somente pelo consumidor
+ */
+typedef struct evento {
+    uint64_t inicio;    ///< Instante do evento, ou incio do trecho de execuo
+    uint64_t fim;       ///< Fim do trecho de execuo
+    uint32_t id;        ///< Linha do diagrama
+    uint32_t tipo;      ///< TIPO_EVENTO
+} evento_t;
+
+typedef struct aneis anel_t;
+
+/* Cria um anel com a capacidade arredondada para a prxima potncia de 2 */
+anel_t *cria_anel(size_t capacidade);
+void desaloca_anel(anel_t *anel);
+
+/* Lado do produtor: 1 se inseriu, 0 se o anel est cheio */
+int anel_insere(anel_t *anel, const evento_t *evento);
+
+/* Lado do consumidor: 1 se retirou, 0 se o anel est vazio */
+int anel_retira(anel_t *anel, evento_t *evento);
+
+#endif // ANEL_H_INCLUDED
@@ -0,0 +1,124 @@
+/** \file arena.c
+ * \brief   Funes para alocao em arena (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arena.h"
+
+typedef struct blocos bloco_t;
+
+struct blocos {
+    bloco_t *proximo;
+    size_t capacidade;
+    size_t usado;
+    // Os dados do bloco seguem o cabealho
+};
+
+struct arenas {
+    bloco_t *primeiro;
+    bloco_t *atual;
+    size_t tamanhoBloco;
+};
+
+#define ALINHA(x)       (((x) + ARENA_ALINHAMENTO - 1) & ~((size_t) ARENA_ALINHAMENTO - 1))
+#define DADOS(bloco)    ((unsigned char*) (bloco) + ALINHA(sizeof(bloco_t)))
+
+static bloco_t *cria_bloco(size_t capacidade)
+{
+    bloco_t *p = malloc(ALINHA(sizeof(bloco_t)) + capacidade);
+
+    if (p == NULL){
+        perror("cria_bloco:");
+        exit(EXIT_FAILURE);
+    }
+
+    p->proximo = NULL;
+    p->capacidade = capacidade;
+    p->usado = 0;
+
+    return p;
+}
+
+arena_t *cria_arena(size_t tamanhoBloco)
+{
+    arena_t *p = malloc(sizeof(arena_t));
+
+    if (p == NULL){
+        perror("cria_arena:");
+        exit(EXIT_FAILURE);
+    }
+
+    if (tamanhoBloco == 0)
+        tamanhoBloco = ARENA_BLOCO_PADRAO;
+
+    p->tamanhoBloco = ALINHA(tamanhoBloco);
+    p->primeiro = cria_bloco(p->tamanhoBloco);
+    p->atual = p->primeiro;
+
+    return p;
+}
+
+void desaloca_arena(arena_t *arena)
+{
+    bloco_t *bloco, *proximo;
+
+    if (arena == NULL){
+        fprintf(stderr,"desaloca_arena: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    for (bloco = arena->primeiro; bloco; bloco = proximo){
+        proximo = bloco->proximo;
+        free(bloco);
+    }
+
+    free(arena);
+}
+
+void *arena_aloca(arena_t *arena, size_t tamanho)
+{
+    bloco_t *bloco;
+    void *p;
+
+    if (arena == NULL){
+        fprintf(stderr,"arena_aloca: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    tamanho = ALINHA(tamanho);
+    bloco = arena->atual;
+
+    // Avana pelos blocos j existentes (de usos anteriores) at achar espao
+    while (bloco->usado + tamanho > bloco->capacidade){
+        if (bloco->proximo == NULL){
+            bloco->proximo = cria_bloco(tamanho > arena->tamanhoBloco ? tamanho : arena->tamanhoBloco);
+        }
+        bloco = bloco->proximo;
+        bloco->usado = 0;
+    }
+
+    arena->atual = bloco;
+    p = DADOS(bloco) + bloco->usado;
+    bloco->usado += tamanho;
+
+    return p;
+}
+
+void arena_reinicia(arena_t *arena)
+{
+    if (arena == NULL){
+        fprintf(stderr,"arena_reinicia: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    arena->atual = arena->primeiro;
+    arena->primeiro->usado = 0;
+}
@@ -0,0 +1,33 @@
+/** \file arena.h
+ * \brief   Cabealho de funes para alocao em arena (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ * A arena reserva memria em blocos grandes e entrega pedaos deles sequencialmente.
+ * No existe liberao individual: tudo que foi alocado  liberado de uma vez por
+ * arena_reinicia(), que mantm os blocos para reutilizao, ou por desaloca_arena().
+ */
+
+#ifndef ARENA_H_INCLUDED
+#define ARENA_H_INCLUDED
+
+#include <stddef.h>
+
+#define ARENA_BLOCO_PADRAO  65536   // Tamanho padro de cada bloco em bytes
+#define ARENA_ALINHAMENTO   16      // Alinhamento de cada alocao
+
+typedef struct arenas arena_t;
+
+arena_t *cria_arena(size_t tamanhoBloco);
+void desaloca_arena(arena_t *arena);
+
+/* Aloca tamanho bytes alinhados na arena */
+void *arena_aloca(arena_t *arena, size_t tamanho);
+
+/* Descarta todas as alocaes, mantendo os blocos para reuso */
+void arena_reinicia(arena_t *arena);
+
+#endif // ARENA_H_INCLUDED
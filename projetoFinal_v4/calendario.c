@@ -0,0 +1,186 @@
+/** \file calendario.c
+ * \brief   Funes para o calendrio de chegadas (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.1
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "calendario.h"
+
+typedef struct entradas entrada_t;
+
+struct entradas {
+    uint64_t instante;
+    int indice;
+    entrada_t *proxima;
+};
+
+struct calendarios {
+    entrada_t **slots;      // Cada posio  uma lista ordenada por (instante, ndice)
+    uint64_t *ocupados;     // Mapa de bits das posies no vazias
+    uint64_t nSlots;
+    uint64_t mascara;
+    entrada_t *entradas;    // Todas as entradas so alocadas na criao
+    entrada_t *livres;
+};
+
+calendario_t *cria_calendario(int capacidade, uint64_t maiorPeriodo)
+{
+    calendario_t *p;
+    int i;
+
+    p = malloc(sizeof(calendario_t));
+    if (p == NULL){
+        perror("cria_calendario:");
+        exit(EXIT_FAILURE);
+    }
+
+    // Menor potncia de 2 maior que o maior perodo, mltipla de 64 por causa do mapa de bits
+    p->nSlots = 64;
+    while (p->nSlots <= maiorPeriodo && p->nSlots < CALENDARIO_MAX_SLOTS)
+        p->nSlots *= 2;
+    p->mascara = p->nSlots - 1;
+
+    if (capacidade < 1)
+        capacidade = 1;
+
+    p->slots = calloc(p->nSlots, sizeof(entrada_t*));
+    p->ocupados = calloc(p->nSlots / 64, sizeof(uint64_t));
+    p->entradas = malloc(capacidade * sizeof(entrada_t));
+    if (p->slots == NULL || p->ocupados == NULL || p->entradas == NULL){
+        perror("cria_calendario:");
+        exit(EXIT_FAILURE);
+    }
+
+    p->livres = NULL;
+    for (i = capacidade - 1; i >= 0; i--){
+        p->entradas[i].proxima = p->livres;
+        p->livres = &p->entradas[i];
+    }
+
+    return p;
+}
+
+void desaloca_calendario(calendario_t *calendario)
+{
+    if (calendario == NULL){
+        fprintf(stderr,"desaloca_calendario: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    free(calendario->slots);
+    free(calendario->ocupados);
+    free(calendario->entradas);
+    free(calendario);
+}
+
+void calendario_agenda(calendario_t *calendario, uint64_t instante, int indice)
+{
+    entrada_t *entrada;
+    entrada_t **p_ant;
+    uint64_t slot;
+
+    if (calendario == NULL){
+        fprintf(stderr,"calendario_agenda: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    entrada = calendario->livres;
+    if (entrada == NULL){
+        fprintf(stderr,"calendario_agenda: capacidade esgotada");
+        exit(EXIT_FAILURE);
+    }
+    calendario->livres = entrada->proxima;
+
+    entrada->instante = instante;
+    entrada->indice = indice;
+
+    slot = instante & calendario->mascara;
+
+    // Insere mantendo a posio ordenada por instante e depois por ndice
+    p_ant = &calendario->slots[slot];
+    while (*p_ant && ((*p_ant)->instante < instante ||
+                      ((*p_ant)->instante == instante && (*p_ant)->indice <= indice)))
+        p_ant = &(*p_ant)->proxima;
+
+    entrada->proxima = *p_ant;
+    *p_ant = entrada;
+
+    calendario->ocupados[slot >> 6] |= (uint64_t) 1 << (slot & 63);
+}
+
+int calendario_retira(calendario_t *calendario, uint64_t instante)
+{
+    entrada_t *entrada;
+    uint64_t slot;
+
+    if (calendario == NULL){
+        fprintf(stderr,"calendario_retira: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    slot = instante & calendario->mascara;
+    entrada = calendario->slots[slot];
+
+    if (entrada == NULL || entrada->instante != instante)
+        return -1;
+
+    calendario->slots[slot] = entrada->proxima;
+    if (calendario->slots[slot] == NULL)
+        calendario->ocupados[slot >> 6] &= ~((uint64_t) 1 << (slot & 63));
+
+    entrada->proxima = calendario->livres;
+    calendario->livres = entrada;
+
+    return entrada->indice;
+}
+
+uint64_t calendario_proximo(calendario_t *calendario, uint64_t tempo)
+{
+    uint64_t d, slot, palavra, menor, w;
+    entrada_t *entrada;
+
+    if (calendario == NULL){
+        fprintf(stderr,"calendario_proximo: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    // Percorre uma volta da roda a partir de tempo+1, saltando palavras vazias do mapa de bits
+    d = 1;
+    while (d <= calendario->nSlots){
+        slot = (tempo + d) & calendario->mascara;
+        palavra = calendario->ocupados[slot >> 6] >> (slot & 63);
+        if (palavra == 0){
+            d += 64 - (slot & 63);
+            continue;
+        }
+        d += __builtin_ctzll(palavra);
+        if (d > calendario->nSlots)
+            break;
+        slot = (tempo + d) & calendario->mascara;
+        if (calendario->slots[slot]->instante == tempo + d)
+            return tempo + d;
+        d++;
+    }
+
+    // Nenhum agendamento na prxima volta: menor instante entre as cabeas das posies
+    menor = UINT64_MAX;
+    for (w = 0; w < calendario->nSlots / 64; w++){
+        palavra = calendario->ocupados[w];
+        while (palavra){
+            slot = w*64 + __builtin_ctzll(palavra);
+            entrada = calendario->slots[slot];
+            if (entrada->instante < menor)
+                menor = entrada->instante;
+            palavra &= palavra - 1;
+        }
+    }
+
+    return menor;
+}
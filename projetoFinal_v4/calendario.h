@@ -0,0 +1,40 @@
+/** \file calendario.h
+ * \brief   Cabealho de funes para o calendrio de chegadas (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.1
+ *
+ * Roda de temporizao (timing wheel) com espalhamento: o instante t  guardado na posio
+ * t & (nSlots-1). Com nSlots maior que o maior perodo nenhuma posio mistura instantes
+ * diferentes e buscar os ndices de um instante custa apenas o nmero de ndices agendados nele.
+ */
+
+#ifndef CALENDARIO_H_INCLUDED
+#define CALENDARIO_H_INCLUDED
+
+#include <inttypes.h>
+
+#define CALENDARIO_MAX_SLOTS    65536   // Limite de posies da roda, deve ser potncia de 2
+
+typedef struct calendarios calendario_t;
+
+/* capacidade: nmero mximo de ndices agendados ao mesmo tempo
+ * maiorPeriodo: maior distncia entre o instante atual e um agendamento */
+calendario_t *cria_calendario(int capacidade, uint64_t maiorPeriodo);
+void desaloca_calendario(calendario_t *calendario);
+
+/* Agenda o ndice para o instante indicado. ndices de um mesmo
+ * instante so retirados em ordem crescente */
+void calendario_agenda(calendario_t *calendario, uint64_t instante, int indice);
+
+/* Retira um ndice agendado exatamente para o instante indicado
+ * -1 caso no haja mais nenhum */
+int calendario_retira(calendario_t *calendario, uint64_t instante);
+
+/* Retorna o primeiro instante posterior a tempo com algum agendamento
+ * UINT64_MAX caso o calendrio esteja vazio */
+uint64_t calendario_proximo(calendario_t *calendario, uint64_t tempo);
+
+#endif // CALENDARIO_H_INCLUDED
@@ -0,0 +1,557 @@
+/** \file escalonador.c
+ * \brief   Motor de simulao do escalonador orientado a eventos.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <inttypes.h>
+#include <pthread.h>
+
+#include "escalonador.h"
+#include "tarefas.h"
+#include "fila_prio.h"
+#include "calendario.h"
+#include "escritor.h"
+
+//#define DEBUG
+
+#define CPU_LIVRE   UINT64_MAX      // Marca que a CPU no est em um perodo ocupado
+#define NENHUMA     -1              // Nenhuma tarefa em execuo
+
+// Estado que determina o restante do escalonamento: para cada tarefa o tempo at a prxima chegada,
+// os "jobs" pendentes e o que falta do atual, mais a tarefa em execuo em cada ncleo
+static void captura_estado(tabela_t* tabela, const int* executando, int nucleos, uint64_t ticks, uint64_t* estado)
+{
+    int i;
+
+    for(i = 0; i < tabela->n; i++){
+        *estado++ = tabela->proximaChegada[i] - ticks;
+        *estado++ = tabela->nmrExe[i];
+        *estado++ = tabela->estado[i] == EXECUTANDO ? tabela->restante[i] - (ticks - tabela->inicio[i])
+                                                    : tabela->restante[i];
+    }
+    for(i = 0; i < nucleos; i++){
+        *estado++ = (uint64_t) executando[i];
+    }
+}
+
+// Estado repetido em ticks: daqui em diante o escalonamento se repete. Sem sada depois de ticks a
+// simulao termina nele; seno s continua para desenhar o diagrama at o fim da janela, que j
+// foi aberta com o intervalo inteiro
+static uint64_t fim_repeticao(escritor_t *escritor, uint64_t ticks, uint64_t hiperPeriodo)
+{
+    uint64_t desenho = escritor_fim(escritor);
+
+    if(desenho <= ticks){
+        return ticks;
+    }
+
+    return desenho < hiperPeriodo ? desenho : hiperPeriodo;
+}
+
+uint64_t escalonador_simula(tabela_t* tabela, const politica_t* politica, uint64_t hiperPeriodo, uint64_t ciclo,
+                            int falhaRapida, int numTarefas, escritor_t *escritor)
+{
+    int tarefaAtual;
+    int tarefaPrio;
+    fila_prio_t* filaProntas;
+    calendario_t* calendario;
+    calendario_t* prazos;
+    uint64_t ticks, tempo_cpu, proximo, termino, maiorPeriodo, verificacao, quebra, repetido;
+    uint64_t *estado, *anterior, *troca;
+    void *salvo;
+    size_t tamanhoEstado;
+    int i, capturado, fimIntervalo;
+
+    if (tabela == NULL || politica == NULL || escritor == NULL) {
+        fprintf(stderr, "escalonador_simula: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    maiorPeriodo = 0;
+    verificacao = 0;
+    for(i = 0; i < tabela->n; i++){
+        if(tabela->periodo[i] > maiorPeriodo){
+            maiorPeriodo = tabela->periodo[i];
+        }
+        if(tabela->fase[i] > verificacao){
+            verificacao = tabela->fase[i];
+        }
+    }
+
+    // O estado  comparado a cada ciclo a partir da maior fase, quando todas as tarefas j chegaram
+    tamanhoEstado = (3*(size_t) tabela->n + 1)*sizeof(uint64_t);
+    estado = malloc(tamanhoEstado);
+    anterior = malloc(tamanhoEstado);
+    if(estado == NULL || anterior == NULL){
+        perror("escalonador_simula:");
+        exit(EXIT_FAILURE);
+    }
+    capturado = 0;
+    repetido = UINT64_MAX;
+    salvo = NULL;
+    if(ciclo == 0){
+        verificacao = UINT64_MAX;
+    }
+
+    filaProntas = cria_fila_prio(tabela->n);
+    calendario = cria_calendario(tabela->n, maiorPeriodo);
+    prazos = cria_calendario(2*tabela->n, maiorPeriodo);     // Com D = T o prazo vence junto com a chegada seguinte
+    tabela_agenda(tabela, calendario);
+
+    ticks = 0;
+    tempo_cpu = CPU_LIVRE;              // Com fases a CPU pode comear ociosa
+    tarefaAtual = NENHUMA;
+    quebra = escritor_quebra(escritor, ticks);
+
+    while(ticks<=hiperPeriodo){
+        if(ticks == verificacao){
+            captura_estado(tabela, &tarefaAtual, 1, ticks, estado);
+            if(capturado && !memcmp(estado, anterior, tamanhoEstado)){
+                repetido = ticks;
+                hiperPeriodo = fim_repeticao(escritor, ticks, hiperPeriodo);
+            }
+            troca = anterior;
+            anterior = estado;
+            estado = troca;
+            capturado = 1;
+            verificacao = verificacao > UINT64_MAX - ciclo || repetido == ticks ? UINT64_MAX : verificacao + ciclo;
+        }
+        if(ticks == quebra){
+            // Limite de pgina do diagrama: divide os trechos em andamento antes dos eventos deste instante
+            if(tarefaAtual != NENHUMA && tabela->inicio[tarefaAtual] < ticks){
+                escritor_execucao(escritor, tabela->id[tarefaAtual], tabela->inicio[tarefaAtual], ticks);
+                tabela->restante[tarefaAtual] -= ticks - tabela->inicio[tarefaAtual];
+                tabela->inicio[tarefaAtual] = ticks;
+            }
+            if(tempo_cpu != CPU_LIVRE && tempo_cpu < ticks){
+                escritor_execucao(escritor, numTarefas+1, tempo_cpu, ticks);
+                tempo_cpu = ticks;
+            }
+            quebra = escritor_quebra(escritor, ticks);
+        }
+        tabela_update(tabela, calendario, prazos, filaProntas, politica, ticks, escritor);
+        tarefaPrio = fila_prio_topo(filaProntas);
+        if(tarefaPrio != NENHUMA){
+            if(tempo_cpu==CPU_LIVRE){
+                tempo_cpu = ticks;
+            }
+            if(tarefaAtual != tarefaPrio){
+                if(tarefaAtual != NENHUMA){
+                    if(tabela_checa_termino(tabela, filaProntas, politica, tarefaAtual, ticks)){
+                        escritor_execucao(escritor, tabela->id[tarefaAtual], tabela->inicio[tarefaAtual], ticks);
+                        escritor_termino(escritor, tabela->id[tarefaAtual], ticks);
+                    }else{
+                        escritor_execucao(escritor, tabela->id[tarefaAtual], tabela->inicio[tarefaAtual], ticks);
+                        tabela_set_pausa(tabela, tarefaAtual, ticks);
+                    }
+                }
+                tarefaAtual = tarefaPrio;
+                tabela_set_inicio(tabela, tarefaAtual, ticks);
+            }
+
+            if(tabela_checa_termino(tabela, filaProntas, politica, tarefaAtual, ticks)){
+                escritor_execucao(escritor, tabela->id[tarefaAtual], tabela->inicio[tarefaAtual], ticks);
+                escritor_termino(escritor, tabela->id[tarefaAtual], ticks);
+                tarefaAtual = fila_prio_topo(filaProntas);
+                if(tarefaAtual != NENHUMA){
+                    tabela_set_inicio(tabela, tarefaAtual, ticks);
+                }else{
+                    escritor_execucao(escritor,numTarefas+1,tempo_cpu,ticks);
+                    tempo_cpu=CPU_LIVRE;
+                }
+            }
+        }else if(tempo_cpu!=CPU_LIVRE){
+            escritor_execucao(escritor,numTarefas+1,tempo_cpu,ticks-1);
+            tempo_cpu=CPU_LIVRE;
+        }
+
+        // Os prazos so verificados depois dos trminos: terminar no prprio prazo no  perda
+        if(tabela_checa_prazos(tabela, prazos, ticks) && falhaRapida){
+            hiperPeriodo = ticks;
+        }
+
+        if(ticks == repetido && hiperPeriodo > ticks){      // Estatsticas at a repetio, inclusive
+            salvo = tabela_salva(tabela);
+        }
+
+        #ifdef DEBUG
+            printf("Tick: %d\n", (int) ticks);
+            imprime_tabela(tabela);
+            puts("");
+        #endif // DEBUG
+
+        // Entre dois eventos nenhuma tarefa chega e a tarefa atual no termina: salta direto ao prximo
+        proximo = calendario_proximo(calendario, ticks);
+        termino = calendario_proximo(prazos, ticks);
+        if(termino < proximo){
+            proximo = termino;
+        }
+        if(tarefaAtual != NENHUMA){
+            termino = tabela_previsao_termino(tabela, tarefaAtual);
+            if(termino > ticks && termino < proximo){
+                proximo = termino;
+            }
+        }
+        if(proximo > verificacao){
+            proximo = verificacao;
+        }
+        if(proximo > quebra){
+            proximo = quebra;
+        }
+        fimIntervalo = ticks == hiperPeriodo || proximo > hiperPeriodo;   // Sem hiperPeriodo + 1, que d a volta com UINT64_MAX
+        if(fimIntervalo){
+            proximo = hiperPeriodo;
+        }
+        if(tarefaAtual != NENHUMA){         // CPU ocupada at o prximo evento, dentro de [0, hiperPeriodo)
+            tabela->tempoOcupado += proximo - ticks;
+        }
+        if(fimIntervalo){
+            break;
+        }
+        ticks = proximo;
+    }
+    if(tempo_cpu!=CPU_LIVRE && tempo_cpu!=hiperPeriodo){
+        escritor_execucao(escritor,numTarefas+1,tempo_cpu,hiperPeriodo);
+    }
+    if(salvo){                          // O desenho passou da repetio: fecha o trecho cortado no fim e volta ao instante dela
+        if(tarefaAtual != NENHUMA && tabela->inicio[tarefaAtual] < hiperPeriodo){
+            escritor_execucao(escritor, tabela->id[tarefaAtual], tabela->inicio[tarefaAtual], hiperPeriodo);
+        }
+        tabela_restaura(tabela, salvo);
+        hiperPeriodo = repetido;
+    }
+    tabela->tempoSimulado = hiperPeriodo;
+    tabela_encerra(tabela, hiperPeriodo);
+
+    free(estado);
+    free(anterior);
+    desaloca_fila_prio(filaProntas);
+    desaloca_calendario(calendario);
+    desaloca_calendario(prazos);
+
+    return hiperPeriodo;
+}
+
+// Coloca a tarefa i no ncleo c; um "job" j iniciado que continua em outro ncleo migrou
+static void despacha(tabela_t* tabela, int* executando, int* nucleoDe, int i, int c, uint64_t ticks)
+{
+    if(tabela->restante[i] != tabela->duracao[i] && nucleoDe[i] != NENHUMA && nucleoDe[i] != c){
+        tabela->migracoes[i]++;
+    }
+    executando[c] = i;
+    nucleoDe[i] = c;
+    tabela_set_inicio(tabela, i, ticks);
+}
+
+uint64_t escalonador_simula_global(tabela_t* tabela, const politica_t* politica, uint64_t hiperPeriodo, uint64_t ciclo,
+                                   int falhaRapida, int numTarefas, int nucleos, escritor_t *escritor)
+{
+    int *executando;        // Tarefa em cada ncleo, NENHUMA se o ncleo est ocioso
+    int *nucleoDe;          // ltimo ncleo em que cada tarefa executou, NENHUMA se nunca executou
+    int *escolhidas;        // As tarefas prontas de maior prioridade, uma por ncleo
+    uint8_t *escolhida;     // Marca das escolhidas, por tarefa
+    uint64_t *tempoCpu;     // Incio do perodo ocupado de cada ncleo, CPU_LIVRE se ocioso
+    fila_prio_t* filaProntas;
+    calendario_t* calendario;
+    calendario_t* prazos;
+    uint64_t ticks, proximo, termino, maiorPeriodo, verificacao, quebra, repetido;
+    uint64_t *estado, *anterior, *troca;
+    void *salvo;
+    size_t tamanhoEstado;
+    int i, c, j, k, ocupados, capturado, fimIntervalo;
+
+    if (tabela == NULL || politica == NULL || escritor == NULL || nucleos < 1) {
+        fprintf(stderr, "escalonador_simula_global: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    maiorPeriodo = 0;
+    verificacao = 0;
+    for(i = 0; i < tabela->n; i++){
+        if(tabela->periodo[i] > maiorPeriodo){
+            maiorPeriodo = tabela->periodo[i];
+        }
+        if(tabela->fase[i] > verificacao){
+            verificacao = tabela->fase[i];
+        }
+    }
+
+    tamanhoEstado = (3*(size_t) tabela->n + nucleos)*sizeof(uint64_t);
+    estado = malloc(tamanhoEstado);
+    anterior = malloc(tamanhoEstado);
+    executando = malloc((size_t) nucleos*sizeof(int));
+    escolhidas = malloc((size_t) nucleos*sizeof(int));
+    tempoCpu = malloc((size_t) nucleos*sizeof(uint64_t));
+    nucleoDe = malloc(((size_t) tabela->n + 1)*sizeof(int));
+    escolhida = calloc((size_t) tabela->n + 1, 1);
+    if(estado == NULL || anterior == NULL || executando == NULL || escolhidas == NULL || tempoCpu == NULL
+       || nucleoDe == NULL || escolhida == NULL){
+        perror("escalonador_simula_global:");
+        exit(EXIT_FAILURE);
+    }
+    capturado = 0;
+    repetido = UINT64_MAX;
+    salvo = NULL;
+    if(ciclo == 0){
+        verificacao = UINT64_MAX;
+    }
+    for(c = 0; c < nucleos; c++){
+        executando[c] = NENHUMA;
+        tempoCpu[c] = CPU_LIVRE;
+    }
+    for(i = 0; i < tabela->n; i++){
+        nucleoDe[i] = NENHUMA;
+    }
+    tabela->nucleos = nucleos;
+
+    filaProntas = cria_fila_prio(tabela->n);
+    calendario = cria_calendario(tabela->n, maiorPeriodo);
+    prazos = cria_calendario(2*tabela->n, maiorPeriodo);
+    tabela_agenda(tabela, calendario);
+
+    ticks = 0;
+    quebra = escritor_quebra(escritor, ticks);
+
+    while(ticks<=hiperPeriodo){
+        if(ticks == verificacao){
+            captura_estado(tabela, executando, nucleos, ticks, estado);
+            if(capturado && !memcmp(estado, anterior, tamanhoEstado)){
+                repetido = ticks;
+                hiperPeriodo = fim_repeticao(escritor, ticks, hiperPeriodo);
+            }
+            troca = anterior;
+            anterior = estado;
+            estado = troca;
+            capturado = 1;
+            verificacao = verificacao > UINT64_MAX - ciclo || repetido == ticks ? UINT64_MAX : verificacao + ciclo;
+        }
+        if(ticks == quebra){
+            for(c = 0; c < nucleos; c++){
+                i = executando[c];
+                if(i != NENHUMA && tabela->inicio[i] < ticks){
+                    escritor_execucao(escritor, tabela->id[i], tabela->inicio[i], ticks);
+                    tabela->restante[i] -= ticks - tabela->inicio[i];
+                    tabela->inicio[i] = ticks;
+                }
+                if(tempoCpu[c] != CPU_LIVRE && tempoCpu[c] < ticks){
+                    escritor_execucao(escritor, numTarefas+c+1, tempoCpu[c], ticks);
+                    tempoCpu[c] = ticks;
+                }
+            }
+            quebra = escritor_quebra(escritor, ticks);
+        }
+        tabela_update(tabela, calendario, prazos, filaProntas, politica, ticks, escritor);
+
+        // Trminos antes da escolha: o ncleo liberado j pode receber outra tarefa neste instante
+        for(c = 0; c < nucleos; c++){
+            i = executando[c];
+            if(i != NENHUMA && tabela_checa_termino(tabela, filaProntas, politica, i, ticks)){
+                escritor_execucao(escritor, tabela->id[i], tabela->inicio[i], ticks);
+                escritor_termino(escritor, tabela->id[i], ticks);
+                executando[c] = NENHUMA;
+            }
+        }
+
+        // Executam as tarefas prontas de maior prioridade, uma por ncleo; as demais em execuo so interrompidas
+        k = fila_prio_menores(filaProntas, nucleos, escolhidas);
+        for(j = 0; j < k; j++){
+            escolhida[escolhidas[j]] = 1;
+        }
+        for(c = 0; c < nucleos; c++){
+            i = executando[c];
+            if(i != NENHUMA && !escolhida[i]){
+                escritor_execucao(escritor, tabela->id[i], tabela->inicio[i], ticks);
+                tabela_set_pausa(tabela, i, ticks);
+                executando[c] = NENHUMA;
+            }
+        }
+        // Primeiro as que podem voltar ao ltimo ncleo em que executaram, depois as demais
+        for(j = 0; j < k; j++){
+            i = escolhidas[j];
+            c = nucleoDe[i];
+            if(tabela->estado[i] != EXECUTANDO && c != NENHUMA && executando[c] == NENHUMA){
+                despacha(tabela, executando, nucleoDe, i, c, ticks);
+            }
+        }
+        c = 0;
+        for(j = 0; j < k; j++){
+            i = escolhidas[j];
+            escolhida[i] = 0;
+            if(tabela->estado[i] == EXECUTANDO){
+                continue;
+            }
+            while(executando[c] != NENHUMA){
+                c++;
+            }
+            despacha(tabela, executando, nucleoDe, i, c, ticks);
+        }
+
+        ocupados = 0;
+        for(c = 0; c < nucleos; c++){
+            if(executando[c] != NENHUMA){
+                ocupados++;
+                if(tempoCpu[c] == CPU_LIVRE){
+                    tempoCpu[c] = ticks;
+                }
+            }else if(tempoCpu[c] != CPU_LIVRE){
+                escritor_execucao(escritor, numTarefas+c+1, tempoCpu[c], ticks);
+                tempoCpu[c] = CPU_LIVRE;
+            }
+        }
+
+        if(tabela_checa_prazos(tabela, prazos, ticks) && falhaRapida){
+            hiperPeriodo = ticks;
+        }
+
+        if(ticks == repetido && hiperPeriodo > ticks){      // Estatsticas at a repetio, inclusive
+            salvo = tabela_salva(tabela);
+        }
+
+        proximo = calendario_proximo(calendario, ticks);
+        termino = calendario_proximo(prazos, ticks);
+        if(termino < proximo){
+            proximo = termino;
+        }
+        for(c = 0; c < nucleos; c++){
+            if(executando[c] != NENHUMA){
+                termino = tabela_previsao_termino(tabela, executando[c]);
+                if(termino > ticks && termino < proximo){
+                    proximo = termino;
+                }
+            }
+        }
+        if(proximo > verificacao){
+            proximo = verificacao;
+        }
+        if(proximo > quebra){
+            proximo = quebra;
+        }
+        fimIntervalo = ticks == hiperPeriodo || proximo > hiperPeriodo;   // Sem hiperPeriodo + 1, que d a volta com UINT64_MAX
+        if(fimIntervalo){
+            proximo = hiperPeriodo;
+        }
+        tabela->tempoOcupado += (uint64_t) ocupados*(proximo - ticks);
+        if(fimIntervalo){
+            break;
+        }
+        ticks = proximo;
+    }
+    // Fecha os trechos ainda abertos no fim do intervalo
+    for(c = 0; c < nucleos; c++){
+        i = executando[c];
+        if(i != NENHUMA && tabela->inicio[i] < hiperPeriodo){
+            escritor_execucao(escritor, tabela->id[i], tabela->inicio[i], hiperPeriodo);
+        }
+        if(tempoCpu[c] != CPU_LIVRE && tempoCpu[c] < hiperPeriodo){
+            escritor_execucao(escritor, numTarefas+c+1, tempoCpu[c], hiperPeriodo);
+        }
+    }
+    if(salvo){                          // O desenho passou da repetio: volta ao instante dela
+        tabela_restaura(tabela, salvo);
+        hiperPeriodo = repetido;
+    }
+    tabela->tempoSimulado = hiperPeriodo;
+    tabela_encerra(tabela, hiperPeriodo);
+
+    free(estado);
+    free(anterior);
+    free(executando);
+    free(escolhidas);
+    free(escolhida);
+    free(tempoCpu);
+    free(nucleoDe);
+    desaloca_fila_prio(filaProntas);
+    desaloca_calendario(calendario);
+    desaloca_calendario(prazos);
+
+    return hiperPeriodo;
+}
+
+// Simulao de um ncleo do escalonamento particionado, executada em sua prpria thread
+typedef struct {
+    tabela_t* tabela;
+    const politica_t* politica;
+    uint64_t hiperPeriodo;
+    uint64_t ciclo;
+    int falhaRapida;
+    int numTarefas;
+    escritor_t* escritor;
+    uint64_t fim;
+    pthread_t thread;
+} nucleo_t;
+
+static void *simula_nucleo(void *arg)
+{
+    nucleo_t* nucleo = arg;
+
+    nucleo->fim = escalonador_simula(nucleo->tabela, nucleo->politica, nucleo->hiperPeriodo, nucleo->ciclo,
+                                     nucleo->falhaRapida, nucleo->numTarefas, nucleo->escritor);
+    escritor_encerra(nucleo->escritor);
+
+    return NULL;
+}
+
+void escalonador_simula_nucleos(tabela_t** tabelas, int nucleos, const politica_t* politica, uint64_t hiperPeriodo,
+                                uint64_t ciclo, int falhaRapida, int numTarefas, escritor_t *escritor, uint64_t* fins)
+{
+    nucleo_t* nucleo;
+    char* criada;
+    int k, erro;
+
+    if (tabelas == NULL || politica == NULL || escritor == NULL || fins == NULL || nucleos < 1) {
+        fprintf(stderr, "escalonador_simula_nucleos: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    nucleo = malloc((size_t) nucleos*sizeof(nucleo_t));
+    criada = calloc((size_t) nucleos, 1);
+    if (nucleo == NULL || criada == NULL) {
+        perror("escalonador_simula_nucleos:");
+        exit(EXIT_FAILURE);
+    }
+
+    for(k = 0; k < nucleos; k++){
+        nucleo[k].tabela = tabelas[k];
+        nucleo[k].politica = politica;
+        nucleo[k].hiperPeriodo = hiperPeriodo;
+        nucleo[k].ciclo = ciclo;
+        nucleo[k].falhaRapida = falhaRapida;
+        nucleo[k].numTarefas = numTarefas + k;          // Linha da CPU do ncleo k: numTarefas+k+1
+        nucleo[k].escritor = escritor_nucleo(escritor, k);
+        nucleo[k].fim = 0;
+
+        if(tabelas[k]->n == 0){                         // Ncleo sem tarefas: s marca o fim dos eventos
+            tabelas[k]->tempoSimulado = hiperPeriodo;
+            escritor_encerra(nucleo[k].escritor);
+            continue;
+        }
+        // Sem a thread no h como continuar: simulado aqui, o ncleo bloquearia no seu anel cheio
+        // enquanto a escrita intercalada espera os eventos dos ncleos seguintes, ainda no criados
+        erro = pthread_create(&nucleo[k].thread, NULL, simula_nucleo, &nucleo[k]);
+        if(erro != 0){
+            errno = erro;
+            perror("escalonador_simula_nucleos:");
+            exit(EXIT_FAILURE);
+        }
+        criada[k] = 1;
+    }
+
+    for(k = 0; k < nucleos; k++){
+        if(criada[k]){
+            pthread_join(nucleo[k].thread, NULL);
+        }
+        fins[k] = tabelas[k]->n ? nucleo[k].fim : hiperPeriodo;
+    }
+
+    free(nucleo);
+    free(criada);
+}
@@ -0,0 +1,96 @@
+/** \file escalonador.h
+ * \brief   Cabealho do motor de simulao do escalonador.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#ifndef ESCALONADOR_H_INCLUDED
+#define ESCALONADOR_H_INCLUDED
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "tabela.h"
+#include "politica.h"
+#include "escritor.h"
+
+/// \brief Simula o escalonamento de uma tabela de tarefas, escrevendo o Diagrama de Gannt.
+/**
+ *  \param tabela: tabela de tarefas criada a partir da lista ordenada por prioridade
+ *  \param politica: poltica de escalonamento, politica_rm ou politica_edf
+ *  \param hiperPeriodo: ltimo instante simulado
+ *  \param ciclo: hiperperodo usado para detectar a repetio do escalonamento, 0 para no detectar
+ *  \param falhaRapida: se diferente de 0, a simulao termina no instante da primeira perda de prazo
+ *  \param numTarefas: nmero de tarefas (a linha da CPU no diagrama  numTarefas+1)
+ *  \param escritor: escritor dos eventos do Diagrama de Gannt
+ *  \return ltimo instante analisado: hiperPeriodo, o da repetio ou o da primeira perda com falhaRapida
+ *  \sa cria_tabela(), ordena_tarefas(), tarefas_calcMMC(), cria_escritor()
+ *
+ * A simulao  orientada a eventos: o tempo avana diretamente para o prximo instante de interesse
+ * (prxima chegada de alguma tarefa ou trmino da tarefa em execuo) em vez de avanar tick a tick.
+ * Os instantes intermedirios no alteram o estado das tarefas, portanto o diagrama gerado  idntico
+ * ao da simulao tick a tick.
+ *
+ * A partir da maior fase o estado das tarefas  comparado a cada ciclo; quando se repete, o restante
+ * do escalonamento  uma cpia do ciclo anterior e a anlise termina nesse instante. Se o escritor
+ * ainda mostra instantes depois dele (escritor_fim()), a simulao continua somente para escrever os
+ * eventos, e a tabela volta depois ao estado do instante da repetio.
+ * Perdas de prazo so detectadas no instante do prazo e contadas na tabela (perdas[], maiorAtraso[]
+ * e atrasoTotal[]), assim como as estatsticas de resposta, preempo e ocupao da CPU, com
+ * memria constante por tarefa.
+ * Nos limites de pgina dados por escritor_quebra() os trechos de execuo em andamento so
+ * divididos, para que cada pgina do diagrama receba somente trechos contidos nela.
+ * \sa tabela_imprime_estatisticas()
+ */
+uint64_t escalonador_simula(tabela_t* tabela, const politica_t* politica, uint64_t hiperPeriodo, uint64_t ciclo,
+                            int falhaRapida, int numTarefas, escritor_t *escritor);
+
+/// \brief Simula o escalonamento global: as tarefas prontas de maior prioridade executam em qualquer um dos ncleos.
+/**
+ *  \param tabela: tabela de tarefas criada a partir da lista ordenada por prioridade
+ *  \param politica: poltica de escalonamento, politica_rm ou politica_edf
+ *  \param hiperPeriodo: ltimo instante simulado
+ *  \param ciclo: hiperperodo usado para detectar a repetio do escalonamento, 0 para no detectar
+ *  \param falhaRapida: se diferente de 0, a simulao termina no instante da primeira perda de prazo
+ *  \param numTarefas: nmero de tarefas (a linha da CPU do ncleo c no diagrama  numTarefas+c+1)
+ *  \param nucleos: nmero de ncleos idnticos
+ *  \param escritor: escritor dos eventos do Diagrama de Gannt
+ *  \return ltimo instante analisado: hiperPeriodo, o da repetio ou o da primeira perda com falhaRapida
+ *  \sa escalonador_simula(), fila_prio_menores()
+ *
+ * Em cada evento executam as nucleos tarefas de menor chave na fila de prontas, e as demais em
+ * execuo so interrompidas (preempes). Uma tarefa escolhida volta de preferncia ao ltimo ncleo
+ * em que executou; quando um "job" interrompido continua em outro ncleo conta uma migrao
+ * (migracoes[]). A tabela guarda o nmero de ncleos para que as estatsticas mostrem as migraes
+ * e a ocupao mdia. Ao contrrio de escalonador_simula(), os trechos ainda em execuo no fim do
+ * intervalo tambm so escritos.
+ */
+uint64_t escalonador_simula_global(tabela_t* tabela, const politica_t* politica, uint64_t hiperPeriodo, uint64_t ciclo,
+                                   int falhaRapida, int numTarefas, int nucleos, escritor_t *escritor);
+
+/// \brief Simula o escalonamento particionado: cada ncleo escalona sozinho a sua tabela, em sua prpria thread.
+/**
+ *  \param tabelas: tabela de cada ncleo, criada a partir da sua lista ordenada por prioridade
+ *  \param nucleos: nmero de ncleos
+ *  \param politica: poltica de escalonamento de todos os ncleos
+ *  \param hiperPeriodo: ltimo instante simulado, o mesmo para todos os ncleos
+ *  \param ciclo: hiperperodo do conjunto inteiro, usado por todos os ncleos para detectar a repetio
+ *  \param falhaRapida: se diferente de 0, cada ncleo termina na sua primeira perda de prazo
+ *  \param numTarefas: nmero total de tarefas (a linha da CPU do ncleo k no diagrama  numTarefas+k+1)
+ *  \param escritor: escritor criado por cria_escritor_nucleos() com o mesmo nmero de ncleos
+ *  \param fins: recebe o ltimo instante simulado em cada ncleo
+ *  \return vazio
+ *  \sa escalonador_simula(), cria_particao(), cria_escritor_nucleos()
+ *
+ * Os ncleos no compartilham estado: cada thread usa somente a sua tabela e o seu anel, e a thread
+ * de escrita intercala os eventos de todos no diagrama. Um ncleo sem tarefas no  simulado.
+ * Com o mesmo ciclo em todos os ncleos, a repetio  detectada no mesmo instante em todos, e as
+ * linhas do diagrama vo at o fim da janela.
+ */
+void escalonador_simula_nucleos(tabela_t** tabelas, int nucleos, const politica_t* politica, uint64_t hiperPeriodo,
+                                uint64_t ciclo, int falhaRapida, int numTarefas, escritor_t *escritor, uint64_t* fins);
+
+#endif // ESCALONADOR_H_INCLUDED
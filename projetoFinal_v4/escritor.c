@@ -0,0 +1,313 @@
+/** \file escritor.c
+ * \brief   Escritor de eventos do Diagrama de Gannt (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "escritor.h"
+#include "anel.h"
+#include "executor.h"
+#include "paginador.h"
+#include "traco.h"
+
+#define TENTATIVAS  64      // Tentativas antes de ceder o processador enquanto o anel est cheio ou vazio
+
+struct escritores {
+    paginador_t *paginador; // NULL quando s o trao  gravado
+    gravador_t *gravador;   // NULL quando no h trao
+    anel_t *anel;           // NULL no modo sequencial
+    pthread_t thread;
+    int numNucleos;         // Produtores intercalados pela thread, 0 com um s produtor
+    escritor_t *nucleos;    // Escritor de cada ncleo: s o anel e os filtros so usados
+};
+
+static void formata(escritor_t *escritor, const evento_t *evento)
+{
+    if (escritor->gravador)
+        gravador_evento(escritor->gravador, evento);
+    if (escritor->paginador)
+        paginador_evento(escritor->paginador, evento);
+}
+
+// Thread de escrita: consome o anel at o evento de fim
+static void *escreve(void *arg)
+{
+    escritor_t *escritor = arg;
+    evento_t evento;
+    int tentativas = 0;
+
+    for (;;){
+        if (!anel_retira(escritor->anel, &evento)){
+            if (++tentativas >= TENTATIVAS){
+                tentativas = 0;
+                sched_yield();
+            }
+            continue;
+        }
+        tentativas = 0;
+        if (evento.tipo == EVENTO_FIM)
+            break;
+        formata(escritor, &evento);
+    }
+
+    return NULL;
+}
+
+// a vem antes de b: por traco_chave(), execues antes dos instantes e ento pelo incio, para que um
+// trecho que termina em um limite de pgina seja desenhado antes da pgina seguinte ser aberta
+static int antes(const evento_t *a, const evento_t *b)
+{
+    uint64_t ca = traco_chave(a), cb = traco_chave(b);
+
+    if (ca != cb)
+        return ca < cb;
+    if ((a->tipo == EVENTO_EXECUCAO) != (b->tipo == EVENTO_EXECUCAO))
+        return a->tipo == EVENTO_EXECUCAO;
+    return a->inicio < b->inicio;
+}
+
+// Thread de escrita com vrios ncleos: cada anel j est em ordem, ento basta intercal-los.
+// Um evento s  escrito quando todos os anis ainda abertos tm um evento  frente
+static void *escreve_nucleos(void *arg)
+{
+    escritor_t *escritor = arg;
+    evento_t *frente;
+    char *estado;           // 0: anel sem evento  frente, 1: evento em frente[k], 2: anel encerrado
+    int k, menor, falta, tentativas = 0;
+
+    frente = malloc((size_t) escritor->numNucleos*sizeof(evento_t));
+    estado = calloc((size_t) escritor->numNucleos, 1);
+    if (frente == NULL || estado == NULL){
+        perror("escreve_nucleos:");
+        exit(EXIT_FAILURE);
+    }
+
+    for (;;){
+        falta = 0;
+        for (k = 0; k < escritor->numNucleos; k++){
+            if (estado[k] == 0){
+                if (anel_retira(escritor->nucleos[k].anel, &frente[k]))
+                    estado[k] = frente[k].tipo == EVENTO_FIM ? 2 : 1;
+                else
+                    falta = 1;
+            }
+        }
+
+        if (falta){
+            if (++tentativas >= TENTATIVAS){
+                tentativas = 0;
+                sched_yield();
+            }
+            continue;
+        }
+        tentativas = 0;
+
+        menor = -1;
+        for (k = 0; k < escritor->numNucleos; k++)
+            if (estado[k] == 1 && (menor < 0 || antes(&frente[k], &frente[menor])))
+                menor = k;
+        if (menor < 0)
+            break;
+
+        formata(escritor, &frente[menor]);
+        estado[menor] = 0;
+    }
+
+    free(frente);
+    free(estado);
+
+    return NULL;
+}
+
+// Entrega um evento: no modo paralelo espera enquanto o anel estiver cheio
+static void entrega(escritor_t *escritor, const evento_t *evento)
+{
+    int tentativas = 0;
+
+    // Fora da janela do diagrama o evento s interessa ao trao: nem chega a ser formatado
+    if (escritor->gravador == NULL && evento->tipo != EVENTO_FIM
+        && (escritor->paginador == NULL || !paginador_visivel(escritor->paginador, evento)))
+        return;
+
+    if (escritor->anel == NULL){
+        formata(escritor, evento);
+        return;
+    }
+
+    while (!anel_insere(escritor->anel, evento)){
+        if (++tentativas >= TENTATIVAS){
+            tentativas = 0;
+            sched_yield();
+        }
+    }
+}
+
+escritor_t *cria_escritor(paginador_t *paginador, gravador_t *gravador, int paralelo)
+{
+    escritor_t *p;
+
+    p = malloc(sizeof(escritor_t));
+    if (p == NULL){
+        perror("cria_escritor:");
+        exit(EXIT_FAILURE);
+    }
+
+    p->paginador = paginador;
+    p->gravador = gravador;
+    p->anel = NULL;
+    p->numNucleos = 0;
+    p->nucleos = NULL;
+
+    if (paralelo && (paginador || gravador) && executor_processadores() > 1){      // Com um s processador a thread s acrescenta trocas de contexto
+        p->anel = cria_anel(ESCRITOR_CAPACIDADE);
+        if (pthread_create(&p->thread, NULL, escreve, p) != 0){
+            // Sem thread, escreve no prprio lao de simulao
+            desaloca_anel(p->anel);
+            p->anel = NULL;
+        }
+    }
+
+    return p;
+}
+
+escritor_t *cria_escritor_nucleos(paginador_t *paginador, gravador_t *gravador, int nucleos)
+{
+    escritor_t *p;
+    int k;
+
+    if ((paginador == NULL && gravador == NULL) || nucleos < 1){
+        fprintf(stderr,"cria_escritor_nucleos: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    p = malloc(sizeof(escritor_t));
+    if (p == NULL){
+        perror("cria_escritor_nucleos:");
+        exit(EXIT_FAILURE);
+    }
+    p->nucleos = malloc((size_t) nucleos*sizeof(escritor_t));
+    if (p->nucleos == NULL){
+        perror("cria_escritor_nucleos:");
+        exit(EXIT_FAILURE);
+    }
+
+    p->paginador = paginador;
+    p->gravador = gravador;
+    p->anel = NULL;
+    p->numNucleos = nucleos;
+
+    for (k = 0; k < nucleos; k++){
+        p->nucleos[k].paginador = paginador;
+        p->nucleos[k].gravador = gravador;
+        p->nucleos[k].anel = cria_anel(ESCRITOR_CAPACIDADE);
+        p->nucleos[k].numNucleos = 0;
+        p->nucleos[k].nucleos = NULL;
+    }
+
+    // Sem a thread no h quem intercale os anis: os ncleos ficariam parados com o anel cheio
+    if (pthread_create(&p->thread, NULL, escreve_nucleos, p) != 0){
+        perror("cria_escritor_nucleos:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+escritor_t *escritor_nucleo(escritor_t *escritor, int k)
+{
+    if (escritor == NULL || k < 0 || k >= escritor->numNucleos){
+        fprintf(stderr,"escritor_nucleo: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    return &escritor->nucleos[k];
+}
+
+void escritor_encerra(escritor_t *escritor)
+{
+    evento_t fim = {0, 0, 0, EVENTO_FIM};
+
+    if (escritor == NULL || escritor->anel == NULL || escritor->numNucleos){
+        fprintf(stderr,"escritor_encerra: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    entrega(escritor, &fim);
+}
+
+void finaliza_escritor(escritor_t *escritor)
+{
+    evento_t fim = {0, 0, 0, EVENTO_FIM};
+    int k;
+
+    if (escritor == NULL){
+        fprintf(stderr,"finaliza_escritor: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    if (escritor->numNucleos){          // Cada ncleo j entregou o seu EVENTO_FIM
+        pthread_join(escritor->thread, NULL);
+        for (k = 0; k < escritor->numNucleos; k++)
+            desaloca_anel(escritor->nucleos[k].anel);
+        free(escritor->nucleos);
+    }else if (escritor->anel){
+        entrega(escritor, &fim);
+        pthread_join(escritor->thread, NULL);
+        desaloca_anel(escritor->anel);
+    }
+
+    free(escritor);
+}
+
+void escritor_chegada(escritor_t *escritor, uint32_t id, uint64_t tempo)
+{
+    evento_t evento = {tempo, 0, id, EVENTO_CHEGADA};
+
+    entrega(escritor, &evento);
+}
+
+void escritor_execucao(escritor_t *escritor, uint32_t id, uint64_t inicio, uint64_t fim)
+{
+    evento_t evento = {inicio, fim, id, EVENTO_EXECUCAO};
+
+    entrega(escritor, &evento);
+}
+
+void escritor_termino(escritor_t *escritor, uint32_t id, uint64_t tempo)
+{
+    evento_t evento = {tempo, 0, id, EVENTO_TERMINO};
+
+    entrega(escritor, &evento);
+}
+
+uint64_t escritor_quebra(escritor_t *escritor, uint64_t tempo)
+{
+    if (escritor == NULL){
+        fprintf(stderr,"escritor_quebra: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    return escritor->paginador ? paginador_quebra(escritor->paginador, tempo) : UINT64_MAX;
+}
+
+uint64_t escritor_fim(escritor_t *escritor)
+{
+    if (escritor == NULL){
+        fprintf(stderr,"escritor_fim: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    if (escritor->gravador)
+        return UINT64_MAX;
+
+    return escritor->paginador ? paginador_fim(escritor->paginador) : 0;
+}
@@ -0,0 +1,63 @@
+/** \file escritor.h
+ * \brief   Cabealho do escritor de eventos do Diagrama de Gannt (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ * O simulador entrega os eventos ao escritor em forma binria. No modo paralelo eles passam por um
+ * anel sem travas para uma thread dedicada, que os desenha pelo paginador e/ou os grava no
+ * trao binrio, e simulao e escrita ocorrem ao mesmo tempo em dois ncleos. O anel tem capacidade fixa: cheio, o simulador
+ * espera a thread de escrita, portanto a memria usada no cresce com a simulao.
+ * No modo sequencial cada evento  formatado imediatamente, sem thread.
+ *
+ * Com vrios ncleos simulados ao mesmo tempo cada um tem o seu escritor e o seu anel, e a nica
+ * thread de escrita intercala os anis em ordem de tempo.
+ */
+
+#ifndef ESCRITOR_H_INCLUDED
+#define ESCRITOR_H_INCLUDED
+
+#include <inttypes.h>
+
+#include "paginador.h"
+#include "traco.h"
+
+#define ESCRITOR_CAPACIDADE     65536   // Eventos no anel entre simulao e escrita
+
+typedef struct escritores escritor_t;
+
+/* Cria o escritor sobre o paginador do .tex e/ou um gravador de trao j abertos (um deles pode ser NULL);
+ * com paralelo != 0 e mais de um processador inicia a thread de escrita. Enquanto o escritor existir,
+ * o paginador e o gravador s devem ser usados por ele. Sem gravador, os eventos fora da janela do
+ * paginador so descartados antes de entrar no anel; sem nenhum dos dois todos so descartados, e a
+ * simulao s preenche as estatsticas da tabela. */
+escritor_t *cria_escritor(paginador_t *paginador, gravador_t *gravador, int paralelo);
+
+/* Cria o escritor de nucleos simuladores, cada um em sua thread, e inicia a thread de escrita */
+escritor_t *cria_escritor_nucleos(paginador_t *paginador, gravador_t *gravador, int nucleos);
+
+/* Escritor que o simulador do ncleo k (0 a nucleos-1) deve usar */
+escritor_t *escritor_nucleo(escritor_t *escritor, int k);
+
+/* Marca o fim dos eventos do escritor de um ncleo - deve ser chamada uma vez por ncleo, mesmo
+ * que ele no tenha sido simulado, antes de finaliza_escritor() */
+void escritor_encerra(escritor_t *escritor);
+
+/* Entrega os eventos pendentes, encerra a thread e libera o escritor - a sada continua aberta */
+void finaliza_escritor(escritor_t *escritor);
+
+void escritor_chegada(escritor_t *escritor, uint32_t id, uint64_t tempo);
+void escritor_execucao(escritor_t *escritor, uint32_t id, uint64_t inicio, uint64_t fim);
+void escritor_termino(escritor_t *escritor, uint32_t id, uint64_t tempo);
+
+/* Prximo limite de pgina do diagrama depois de tempo, UINT64_MAX se no houver: o simulador
+ * divide nele os trechos de execuo em andamento */
+uint64_t escritor_quebra(escritor_t *escritor, uint64_t tempo);
+
+/* ltimo instante que ainda aparece na sada: o fim da janela do diagrama, UINT64_MAX com trao
+ * e 0 no escritor mudo. Depois dele o simulador pode parar sem mudar o que  escrito */
+uint64_t escritor_fim(escritor_t *escritor);
+
+#endif // ESCRITOR_H_INCLUDED
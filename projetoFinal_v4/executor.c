@@ -0,0 +1,319 @@
+/** \file executor.c
+ * \brief   Executor de trabalhos com roubo de trabalho (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "executor.h"
+
+#define CAPACIDADE_INICIAL  64      // Trabalhos em cada fila antes de crescer (potncia de 2)
+
+typedef struct {
+    executor_trabalho_t trabalho;
+    void *arg;
+} item_t;
+
+// Fila dupla circular: a dona retira pelo fim, as outras threads roubam pelo incio
+typedef struct {
+    pthread_mutex_t trava;
+    item_t *itens;
+    size_t inicio;          // Posio do item mais antigo
+    size_t tamanho;
+    size_t capacidade;      // Potncia de 2
+} deque_t;
+
+typedef struct {
+    executor_t *executor;
+    int indice;
+} trabalhadora_t;
+
+struct executores {
+    deque_t *deques;                // Uma fila por trabalhadora
+    pthread_t *threads;
+    trabalhadora_t *trabalhadoras;
+    int numTrabalhadores;           // Filas e ndices existentes
+    int ativas;                     // Threads efetivamente criadas, 0 no modo sequencial
+    int proxima;                    // Fila que recebe a prxima submisso
+    atomic_size_t disponiveis;      // Trabalhos nas filas, ainda no retirados
+    atomic_size_t pendentes;        // Trabalhos submetidos e ainda no terminados
+    int encerrar;
+    pthread_mutex_t trava;          // Protege encerrar e as esperas nas condies
+    pthread_cond_t haTrabalho;
+    pthread_cond_t concluido;
+};
+
+long executor_processadores(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return n > 0 ? n : 1;
+#else
+    return 1;
+#endif
+}
+
+static void deque_insere(deque_t *deque, const item_t *item)
+{
+    item_t *itens;
+    size_t i;
+
+    pthread_mutex_lock(&deque->trava);
+    if (deque->tamanho == deque->capacidade){
+        itens = malloc(2*deque->capacidade*sizeof(item_t));
+        if (itens == NULL){
+            perror("executor_submete:");
+            exit(EXIT_FAILURE);
+        }
+        for (i = 0; i < deque->tamanho; i++)
+            itens[i] = deque->itens[(deque->inicio + i) & (deque->capacidade - 1)];
+        free(deque->itens);
+        deque->itens = itens;
+        deque->inicio = 0;
+        deque->capacidade *= 2;
+    }
+    deque->itens[(deque->inicio + deque->tamanho++) & (deque->capacidade - 1)] = *item;
+    pthread_mutex_unlock(&deque->trava);
+}
+
+// Retirada pela dona: o trabalho mais recente
+static int deque_retira(deque_t *deque, item_t *item)
+{
+    int ret = 0;
+
+    pthread_mutex_lock(&deque->trava);
+    if (deque->tamanho > 0){
+        *item = deque->itens[(deque->inicio + --deque->tamanho) & (deque->capacidade - 1)];
+        ret = 1;
+    }
+    pthread_mutex_unlock(&deque->trava);
+
+    return ret;
+}
+
+// Roubo: o trabalho mais antigo, o mais distante do que a dona est executando
+static int deque_rouba(deque_t *deque, item_t *item)
+{
+    int ret = 0;
+
+    if (pthread_mutex_trylock(&deque->trava) != 0)
+        return 0;           // Outra thread est usando a fila: tenta a prxima
+    if (deque->tamanho > 0){
+        *item = deque->itens[deque->inicio];
+        deque->inicio = (deque->inicio + 1) & (deque->capacidade - 1);
+        deque->tamanho--;
+        ret = 1;
+    }
+    pthread_mutex_unlock(&deque->trava);
+
+    return ret;
+}
+
+// Prximo trabalho da trabalhadora k: primeiro da sua fila, depois das outras a partir da seguinte
+static int obtem(executor_t *executor, int k, item_t *item)
+{
+    int i;
+
+    if (deque_retira(&executor->deques[k], item))
+        return 1;
+
+    for (i = 1; i < executor->numTrabalhadores; i++)
+        if (deque_rouba(&executor->deques[(k + i) % executor->numTrabalhadores], item))
+            return 1;
+
+    return 0;
+}
+
+static void termina(executor_t *executor)
+{
+    if (atomic_fetch_sub(&executor->pendentes, 1) == 1){
+        pthread_mutex_lock(&executor->trava);
+        pthread_cond_broadcast(&executor->concluido);
+        pthread_mutex_unlock(&executor->trava);
+    }
+}
+
+static void *trabalha(void *arg)
+{
+    trabalhadora_t *t = arg;
+    executor_t *executor = t->executor;
+    item_t item;
+
+    for (;;){
+        if (atomic_load(&executor->disponiveis) > 0 && obtem(executor, t->indice, &item)){
+            atomic_fetch_sub(&executor->disponiveis, 1);
+            item.trabalho(item.arg, t->indice);
+            termina(executor);
+            continue;
+        }
+
+        // Um trabalho pode ter sido retirado por outra thread entre a contagem e o roubo: s dorme sem nenhum
+        pthread_mutex_lock(&executor->trava);
+        while (atomic_load(&executor->disponiveis) == 0 && !executor->encerrar)
+            pthread_cond_wait(&executor->haTrabalho, &executor->trava);
+        if (atomic_load(&executor->disponiveis) == 0 && executor->encerrar){
+            pthread_mutex_unlock(&executor->trava);
+            break;
+        }
+        pthread_mutex_unlock(&executor->trava);
+    }
+
+    return NULL;
+}
+
+executor_t *cria_executor(int trabalhadores)
+{
+    executor_t *p;
+    int k;
+
+    if (trabalhadores < 1)
+        trabalhadores = (int) executor_processadores();
+
+    p = malloc(sizeof(executor_t));
+    if (p == NULL){
+        perror("cria_executor:");
+        exit(EXIT_FAILURE);
+    }
+
+    p->deques = malloc(trabalhadores*sizeof(deque_t));
+    p->threads = malloc(trabalhadores*sizeof(pthread_t));
+    p->trabalhadoras = malloc(trabalhadores*sizeof(trabalhadora_t));
+    if (p->deques == NULL || p->threads == NULL || p->trabalhadoras == NULL){
+        perror("cria_executor:");
+        exit(EXIT_FAILURE);
+    }
+
+    for (k = 0; k < trabalhadores; k++){
+        pthread_mutex_init(&p->deques[k].trava, NULL);
+        p->deques[k].itens = malloc(CAPACIDADE_INICIAL*sizeof(item_t));
+        if (p->deques[k].itens == NULL){
+            perror("cria_executor:");
+            exit(EXIT_FAILURE);
+        }
+        p->deques[k].inicio = 0;
+        p->deques[k].tamanho = 0;
+        p->deques[k].capacidade = CAPACIDADE_INICIAL;
+        p->trabalhadoras[k].executor = p;
+        p->trabalhadoras[k].indice = k;
+    }
+
+    p->numTrabalhadores = trabalhadores;
+    p->proxima = 0;
+    p->encerrar = 0;
+    atomic_init(&p->disponiveis, 0);
+    atomic_init(&p->pendentes, 0);
+    pthread_mutex_init(&p->trava, NULL);
+    pthread_cond_init(&p->haTrabalho, NULL);
+    pthread_cond_init(&p->concluido, NULL);
+
+    // As filas das threads que no puderam ser criadas nunca recebem trabalhos
+    for (p->ativas = 0; p->ativas < trabalhadores; p->ativas++)
+        if (pthread_create(&p->threads[p->ativas], NULL, trabalha, &p->trabalhadoras[p->ativas]) != 0)
+            break;
+
+    return p;
+}
+
+int executor_trabalhadores(executor_t *executor)
+{
+    if (executor == NULL){
+        fprintf(stderr,"executor_trabalhadores: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    return executor->numTrabalhadores;
+}
+
+void executor_submete(executor_t *executor, executor_trabalho_t trabalho, void *arg)
+{
+    item_t item;
+
+    if (executor == NULL || trabalho == NULL){
+        fprintf(stderr,"executor_submete: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    if (executor->ativas == 0){         // Sem threads: executa na hora
+        trabalho(arg, 0);
+        return;
+    }
+
+    item.trabalho = trabalho;
+    item.arg = arg;
+
+    atomic_fetch_add(&executor->pendentes, 1);
+    deque_insere(&executor->deques[executor->proxima], &item);
+    executor->proxima = (executor->proxima + 1) % executor->ativas;
+
+    // A contagem muda antes da trava: a thread que testou a condio j est esperando ou v o trabalho
+    atomic_fetch_add(&executor->disponiveis, 1);
+    pthread_mutex_lock(&executor->trava);
+    pthread_cond_signal(&executor->haTrabalho);
+    pthread_mutex_unlock(&executor->trava);
+}
+
+void executor_espera(executor_t *executor)
+{
+    if (executor == NULL){
+        fprintf(stderr,"executor_espera: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    pthread_mutex_lock(&executor->trava);
+    while (atomic_load(&executor->pendentes) > 0)
+        pthread_cond_wait(&executor->concluido, &executor->trava);
+    pthread_mutex_unlock(&executor->trava);
+}
+
+void finaliza_executor(executor_t *executor)
+{
+    int k;
+
+    if (executor == NULL){
+        fprintf(stderr,"finaliza_executor: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    executor_espera(executor);
+
+    pthread_mutex_lock(&executor->trava);
+    executor->encerrar = 1;
+    pthread_cond_broadcast(&executor->haTrabalho);
+    pthread_mutex_unlock(&executor->trava);
+
+    for (k = 0; k < executor->ativas; k++)
+        pthread_join(executor->threads[k], NULL);
+
+    for (k = 0; k < executor->numTrabalhadores; k++){
+        pthread_mutex_destroy(&executor->deques[k].trava);
+        free(executor->deques[k].itens);
+    }
+    pthread_mutex_destroy(&executor->trava);
+    pthread_cond_destroy(&executor->haTrabalho);
+    pthread_cond_destroy(&executor->concluido);
+
+    free(executor->deques);
+    free(executor->threads);
+    free(executor->trabalhadoras);
+    free(executor);
+}
@@ -0,0 +1,43 @@
+/** \file executor.h
+ * \brief   Cabealho do executor de trabalhos com roubo de trabalho (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ * Conjunto fixo de threads trabalhadoras, cada uma com a sua fila dupla de trabalhos. Os trabalhos
+ * submetidos so distribudos entre as filas em rodzio; cada trabalhadora retira da sua fila pelo
+ * fim e, quando ela esvazia, rouba pelo incio da fila de outra. Assim trabalhos de durao muito
+ * diferente no deixam ncleos parados enquanto outro ainda tem uma fila longa.
+ */
+
+#ifndef EXECUTOR_H_INCLUDED
+#define EXECUTOR_H_INCLUDED
+
+/* Trabalho submetido: recebe o argumento dado na submisso e o ndice (0 a trabalhadores-1) da
+ * thread que o executa, para que cada thread use somente os seus prprios recursos */
+typedef void (*executor_trabalho_t)(void *arg, int trabalhador);
+
+typedef struct executores executor_t;
+
+/* Nmero de processadores disponveis, 1 se no for possvel saber */
+long executor_processadores(void);
+
+/* Cria o executor e inicia as threads; com trabalhadores < 1 usa uma thread por processador.
+ * Se nenhuma thread puder ser criada, os trabalhos so executados na prpria submisso */
+executor_t *cria_executor(int trabalhadores);
+
+/* Nmero de ndices de trabalhadora que os trabalhos podem receber */
+int executor_trabalhadores(executor_t *executor);
+
+/* Submete um trabalho - deve ser chamada somente pela thread que criou o executor */
+void executor_submete(executor_t *executor, executor_trabalho_t trabalho, void *arg);
+
+/* Espera at que todos os trabalhos submetidos terminem */
+void executor_espera(executor_t *executor);
+
+/* Espera os trabalhos pendentes, encerra as threads e libera o executor */
+void finaliza_executor(executor_t *executor);
+
+#endif // EXECUTOR_H_INCLUDED
@@ -0,0 +1,261 @@
+/** \file fila_prio.c
+ * \brief   Funes para fila de prioridades (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.1
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fila_prio.h"
+
+#define FALSE 0
+#define TRUE 1
+
+#define FORA_DA_FILA    -1
+
+struct filas_prio {
+    int *heap;          // ndices organizados como heap
+    int *posicao;       // Posio de cada ndice no heap, FORA_DA_FILA se ausente
+    uint64_t *chave;    // Chave de cada ndice
+    int *candidatos;    // Posies do heap visitadas por fila_prio_menores()
+    int tamanho;
+    int capacidade;
+};
+
+// Verifica se o ndice a deve ficar acima do ndice b no heap
+static int precede(fila_prio_t *fila, int a, int b)
+{
+    if (fila->chave[a] != fila->chave[b])
+        return fila->chave[a] < fila->chave[b];
+
+    return a < b;
+}
+
+static void sobe(fila_prio_t *fila, int i)
+{
+    int indice = fila->heap[i];
+    int pai;
+
+    while (i > 0){
+        pai = (i - 1) / 2;
+        if (!precede(fila, indice, fila->heap[pai]))
+            break;
+        fila->heap[i] = fila->heap[pai];
+        fila->posicao[fila->heap[i]] = i;
+        i = pai;
+    }
+    fila->heap[i] = indice;
+    fila->posicao[indice] = i;
+}
+
+static void desce(fila_prio_t *fila, int i)
+{
+    int indice = fila->heap[i];
+    int filho;
+
+    while ((filho = 2*i + 1) < fila->tamanho){
+        if (filho + 1 < fila->tamanho && precede(fila, fila->heap[filho + 1], fila->heap[filho]))
+            filho++;
+        if (!precede(fila, fila->heap[filho], indice))
+            break;
+        fila->heap[i] = fila->heap[filho];
+        fila->posicao[fila->heap[i]] = i;
+        i = filho;
+    }
+    fila->heap[i] = indice;
+    fila->posicao[indice] = i;
+}
+
+//cria uma fila vazia
+fila_prio_t *cria_fila_prio(int capacidade)
+{
+    fila_prio_t *p = malloc(sizeof(fila_prio_t));
+    int i;
+
+    if (p == NULL){
+        perror("cria_fila_prio:");
+        exit(EXIT_FAILURE);
+    }
+
+    if (capacidade < 1)
+        capacidade = 1;
+
+    p->heap = malloc(capacidade * sizeof(int));
+    p->posicao = malloc(capacidade * sizeof(int));
+    p->chave = malloc(capacidade * sizeof(uint64_t));
+    p->candidatos = malloc((capacidade + 1) * sizeof(int));
+    if (p->heap == NULL || p->posicao == NULL || p->chave == NULL || p->candidatos == NULL){
+        perror("cria_fila_prio:");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < capacidade; i++)
+        p->posicao[i] = FORA_DA_FILA;
+
+    p->tamanho = 0;
+    p->capacidade = capacidade;
+
+    return p;
+}
+
+void desaloca_fila_prio(fila_prio_t *fila)
+{
+    if (fila == NULL){
+        fprintf(stderr,"desaloca_fila_prio: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    free(fila->heap);
+    free(fila->posicao);
+    free(fila->chave);
+    free(fila->candidatos);
+    free(fila);
+}
+
+void fila_prio_insere(fila_prio_t *fila, int indice, uint64_t chave)
+{
+    if (fila == NULL || indice < 0 || indice >= fila->capacidade){
+        fprintf(stderr,"fila_prio_insere: parametros invalidos");
+        exit(EXIT_FAILURE);
+    }
+
+    if (fila->posicao[indice] != FORA_DA_FILA){
+        fprintf(stderr,"fila_prio_insere: indice ja esta na fila");
+        exit(EXIT_FAILURE);
+    }
+
+    fila->chave[indice] = chave;
+    fila->heap[fila->tamanho] = indice;
+    sobe(fila, fila->tamanho++);
+}
+
+void fila_prio_remove(fila_prio_t *fila, int indice)
+{
+    int i, ultimo;
+
+    if (fila == NULL || indice < 0 || indice >= fila->capacidade){
+        fprintf(stderr,"fila_prio_remove: parametros invalidos");
+        exit(EXIT_FAILURE);
+    }
+
+    i = fila->posicao[indice];
+    if (i == FORA_DA_FILA)
+        return;
+
+    fila->posicao[indice] = FORA_DA_FILA;
+    ultimo = fila->heap[--fila->tamanho];
+    if (i == fila->tamanho)
+        return;
+
+    // O ltimo elemento ocupa a posio liberada e  reposicionado
+    fila->heap[i] = ultimo;
+    fila->posicao[ultimo] = i;
+    if (i > 0 && precede(fila, ultimo, fila->heap[(i - 1) / 2]))
+        sobe(fila, i);
+    else
+        desce(fila, i);
+}
+
+void fila_prio_atualiza(fila_prio_t *fila, int indice, uint64_t chave)
+{
+    int i;
+
+    if (fila == NULL || indice < 0 || indice >= fila->capacidade){
+        fprintf(stderr,"fila_prio_atualiza: parametros invalidos");
+        exit(EXIT_FAILURE);
+    }
+
+    i = fila->posicao[indice];
+    if (i == FORA_DA_FILA){
+        fprintf(stderr,"fila_prio_atualiza: indice nao esta na fila");
+        exit(EXIT_FAILURE);
+    }
+
+    if (chave < fila->chave[indice]){
+        fila->chave[indice] = chave;
+        sobe(fila, i);
+    }else{
+        fila->chave[indice] = chave;
+        desce(fila, i);
+    }
+}
+
+int fila_prio_topo(fila_prio_t *fila)
+{
+    if (fila == NULL){
+        fprintf(stderr,"fila_prio_topo: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    if (fila->tamanho == 0)
+        return -1;
+
+    return fila->heap[0];
+}
+
+int fila_prio_menores(fila_prio_t *fila, int k, int *indices)
+{
+    int encontrados, numCandidatos, melhor, i, pos;
+
+    if (fila == NULL || (indices == NULL && k > 0)){
+        fprintf(stderr,"fila_prio_menores: parametros invalidos");
+        exit(EXIT_FAILURE);
+    }
+
+    // Os k menores formam uma subrvore a partir da raiz: a cada passo o menor candidato sai e
+    // seus filhos entram, portanto nunca h mais de k + 1 candidatos
+    numCandidatos = 0;
+    if (fila->tamanho > 0)
+        fila->candidatos[numCandidatos++] = 0;
+
+    for (encontrados = 0; encontrados < k && numCandidatos > 0; encontrados++){
+        melhor = 0;
+        for (i = 1; i < numCandidatos; i++)
+            if (precede(fila, fila->heap[fila->candidatos[i]], fila->heap[fila->candidatos[melhor]]))
+                melhor = i;
+
+        pos = fila->candidatos[melhor];
+        indices[encontrados] = fila->heap[pos];
+        fila->candidatos[melhor] = fila->candidatos[--numCandidatos];
+
+        if (2*pos + 1 < fila->tamanho)
+            fila->candidatos[numCandidatos++] = 2*pos + 1;
+        if (2*pos + 2 < fila->tamanho)
+            fila->candidatos[numCandidatos++] = 2*pos + 2;
+    }
+
+    return encontrados;
+}
+
+int fila_prio_contem(fila_prio_t *fila, int indice)
+{
+    int ret;
+
+    (fila->posicao[indice] != FORA_DA_FILA) ? (ret = TRUE) : (ret = FALSE);
+
+    return ret;
+}
+
+int fila_prio_vazia(fila_prio_t *fila)
+{
+    int ret;
+
+    (fila->tamanho == 0) ? (ret = TRUE) : (ret = FALSE);
+
+    return ret;
+}
+
+int tamanho_fila_prio(fila_prio_t *fila)
+{
+    if (fila == NULL){
+        fprintf(stderr,"tamanho_fila_prio: ponteiros invalidos");
+        exit(EXIT_FAILURE);
+    }
+
+    return fila->tamanho;
+}
@@ -0,0 +1,45 @@
+/** \file fila_prio.h
+ * \brief   Cabealho de funes para fila de prioridades (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.1
+ *
+ * Heap binrio de mnimo indexado: guarda ndices de 0 a capacidade-1, cada um com uma chave.
+ * O ndice de menor chave  o de maior prioridade; empates so desfeitos pelo menor ndice.
+ * A posio de cada ndice no heap  conhecida, permitindo remover qualquer elemento.
+ */
+
+#ifndef FILA_PRIO_H_INCLUDED
+#define FILA_PRIO_H_INCLUDED
+
+#include <inttypes.h>
+
+typedef struct filas_prio fila_prio_t;
+
+fila_prio_t *cria_fila_prio(int capacidade);
+void desaloca_fila_prio(fila_prio_t *fila);
+
+/* Insere o ndice com a chave indicada - O(log n) */
+void fila_prio_insere(fila_prio_t *fila, int indice, uint64_t chave);
+
+/* Remove o ndice, esteja onde estiver no heap - O(log n) */
+void fila_prio_remove(fila_prio_t *fila, int indice);
+
+/* Troca a chave de um ndice que j est na fila - O(log n) */
+void fila_prio_atualiza(fila_prio_t *fila, int indice, uint64_t chave);
+
+/* Retorna o ndice de menor chave sem remov-lo - O(1)
+ * -1 caso a fila esteja vazia */
+int fila_prio_topo(fila_prio_t *fila);
+
+/* Escreve em indices os k ndices de menor chave, em ordem, sem remov-los - O(k^2)
+ * Retorna quantos foram escritos, menos que k se a fila tiver menos elementos */
+int fila_prio_menores(fila_prio_t *fila, int k, int *indices);
+
+int fila_prio_contem(fila_prio_t *fila, int indice);
+int fila_prio_vazia(fila_prio_t *fila);
+int tamanho_fila_prio(fila_prio_t *fila);
+
+#endif // FILA_PRIO_H_INCLUDED
@@ -0,0 +1,406 @@
+/** \file gerador.c
+ * \brief   Gerador de conjuntos de tarefas sintticos.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+
+#include "gerador.h"
+#include "tarefas.h"
+#include "no.h"
+
+// Estado do xoshiro256**, local a cada conjunto
+typedef struct {
+    uint64_t s[4];
+} sorteio_t;
+
+static uint64_t splitmix64(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static uint64_t rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+static uint64_t proximo(sorteio_t *r)
+{
+    uint64_t resultado = rotl(r->s[1]*5, 7)*9;
+    uint64_t t = r->s[1] << 17;
+
+    r->s[2] ^= r->s[0];
+    r->s[3] ^= r->s[1];
+    r->s[1] ^= r->s[2];
+    r->s[0] ^= r->s[3];
+    r->s[2] ^= t;
+    r->s[3] = rotl(r->s[3], 45);
+
+    return resultado;
+}
+
+// Nmero real uniforme em [0, 1)
+static double uniforme(sorteio_t *r)
+{
+    return (proximo(r) >> 11)*0x1.0p-53;
+}
+
+// O conjunto k tem o seu prprio estado, derivado da semente e de k
+static void semeia(sorteio_t *r, uint64_t semente, long k)
+{
+    uint64_t x = semente ^ ((uint64_t) k*0xD1B54A32D192ED03ULL);
+    int i;
+
+    for (i = 0; i < 4; i++)
+        r->s[i] = splitmix64(&x);
+}
+
+// UUniFast: n utilizaes uniformes no simplex de soma total
+static void uunifast(sorteio_t *r, int n, double total, double *u)
+{
+    double soma = total, proxima;
+    int i;
+
+    for (i = 1; i < n; i++){
+        proxima = soma*pow(uniforme(r), 1.0/(n - i));
+        u[i - 1] = soma - proxima;
+        soma = proxima;
+    }
+    u[n - 1] = soma;
+}
+
+// RandFixedSum de Stafford com limites [0, 1]: probabilidades de transio entre as faixas de soma,
+// que s dependem de n e do total e servem para todos os sorteios do conjunto
+static double *randfixedsum_tabela(int n, double total, arena_t *arena)
+{
+    double *s1, *s2, *w, *t, *linha, *anterior;
+    double s, tmp1, tmp2, tmp3;
+    int i, c, k;
+
+    s1 = arena_aloca(arena, n*sizeof(double));
+    s2 = arena_aloca(arena, n*sizeof(double));
+    w = arena_aloca(arena, (size_t) n*(n + 1)*sizeof(double));
+    t = arena_aloca(arena, (size_t) (n > 1 ? n - 1 : 1)*n*sizeof(double));
+
+    k = (int) floor(total);
+    if (k > n - 1) k = n - 1;
+    if (k < 0) k = 0;
+    s = total;
+    if (s > k + 1) s = k + 1;
+    if (s < k) s = k;
+
+    for (i = 0; i < n; i++){
+        s1[i] = s - (k - i);
+        s2[i] = (k + n - i) - s;
+    }
+
+    // Volumes dos politopos de cada dimenso; t[i-2][c-1]  a probabilidade de descer de faixa
+    memset(w, 0, (size_t) n*(n + 1)*sizeof(double));
+    w[1] = DBL_MAX;
+    for (i = 2; i <= n; i++){
+        anterior = w + (size_t) (i - 2)*(n + 1);
+        linha = w + (size_t) (i - 1)*(n + 1);
+        for (c = 1; c <= i; c++){
+            tmp1 = anterior[c]*s1[c - 1]/i;
+            tmp2 = anterior[c - 1]*s2[n - i + c - 1]/i;
+            linha[c] = tmp1 + tmp2;
+            tmp3 = linha[c] + DBL_MIN;
+            if (s2[n - i + c - 1] > s1[c - 1])
+                t[(size_t) (i - 2)*n + c - 1] = tmp2/tmp3;
+            else
+                t[(size_t) (i - 2)*n + c - 1] = 1 - tmp1/tmp3;
+        }
+    }
+
+    return t;
+}
+
+// RandFixedSum: n valores uniformes em [0, 1] entre os de soma total, com a tabela de randfixedsum_tabela()
+static void randfixedsum(sorteio_t *r, int n, double total, const double *t, double *u)
+{
+    double s, sx, sm, pr, troca;
+    int i, c, j, k, e;
+
+    k = (int) floor(total);
+    if (k > n - 1) k = n - 1;
+    if (k < 0) k = 0;
+    s = total;
+    if (s > k + 1) s = k + 1;
+    if (s < k) s = k;
+
+    j = k + 1;
+    sm = 0;
+    pr = 1;
+    for (i = n - 1; i >= 1; i--){
+        e = uniforme(r) <= t[(size_t) (i - 1)*n + j - 1];
+        sx = pow(uniforme(r), 1.0/i);
+        sm += (1 - sx)*pr*s/(i + 1);
+        pr *= sx;
+        u[n - i - 1] = sm + pr*e;
+        s -= e;
+        j -= e;
+    }
+    u[n - 1] = sm + pr*s;
+
+    // Os valores saem em ordem de construo: embaralha
+    for (i = n - 1; i > 0; i--){
+        c = (int) (proximo(r) % (uint64_t) (i + 1));
+        troca = u[i];
+        u[i] = u[c];
+        u[c] = troca;
+    }
+}
+
+static uint64_t periodo(sorteio_t *r, const gerador_opcoes_t *o)
+{
+    uint64_t p, faixa;
+    int potencias;
+
+    switch (o->periodos){
+        case PERIODO_UNIFORME:
+            faixa = o->periodoMax - o->periodoMin + 1;
+            p = o->periodoMin + (uint64_t) (uniforme(r)*faixa);
+            break;
+        case PERIODO_LOG_UNIFORME:
+            p = (uint64_t) exp(log((double) o->periodoMin)
+                               + uniforme(r)*(log((double) o->periodoMax + 1) - log((double) o->periodoMin)));
+            break;
+        default:
+            for (potencias = 0; o->periodoMax >> (potencias + 1) >= o->periodoMin; potencias++)
+                ;
+            p = o->periodoMin << (int) (proximo(r) % (uint64_t) (potencias + 1));
+            break;
+    }
+
+    if (p < o->periodoMin) p = o->periodoMin;
+    if (p > o->periodoMax) p = o->periodoMax;
+
+    return p;
+}
+
+int gerador_conjunto(const gerador_opcoes_t *opcoes, long k, arena_t *arena, lista_enc_t *listaTarefas)
+{
+    sorteio_t r;
+    double *u, *tabela = NULL, c, total;
+    uint64_t *periodos, *duracoes;
+    int n, i, tentativa;
+
+    if (opcoes == NULL || arena == NULL || listaTarefas == NULL){
+        fprintf(stderr, "gerador_conjunto: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    semeia(&r, opcoes->semente, k);
+
+    n = opcoes->tarefas;
+    u = arena_aloca(arena, n*sizeof(double));
+    periodos = arena_aloca(arena, n*sizeof(uint64_t));
+    duracoes = arena_aloca(arena, n*sizeof(uint64_t));
+    if (opcoes->metodo == METODO_RANDFIXEDSUM)
+        tabela = randfixedsum_tabela(n, opcoes->utilizacao, arena);
+
+    // Duraes inteiras desviam a utilizao do alvo, mais com perodos curtos: o conjunto  sorteado
+    // de novo at que a utilizao arredondada fique dentro da tolerncia
+    for (tentativa = 0; tentativa < GERADOR_TENTATIVAS; tentativa++){
+        if (opcoes->metodo == METODO_UUNIFAST)
+            uunifast(&r, n, opcoes->utilizacao, u);
+        else
+            randfixedsum(&r, n, opcoes->utilizacao, tabela, u);
+
+        total = 0;
+        for (i = 0; i < n; i++){
+            periodos[i] = periodo(&r, opcoes);
+            c = floor(u[i]*periodos[i] + 0.5);
+            duracoes[i] = c < 1 ? 1 : (c > periodos[i] ? periodos[i] : (uint64_t) c);  // Ao menos 1 tick, no mximo o perodo
+            total += (double) duracoes[i]/periodos[i];
+        }
+
+        if (fabs(total - opcoes->utilizacao) <= opcoes->tolerancia*opcoes->utilizacao){
+            for (i = 0; i < n; i++)
+                add_cauda(listaTarefas, cria_no_arena(arena, (void*) cria_tarefa_arena(arena, (uint32_t) i + 1,
+                                                                                         duracoes[i], periodos[i])));
+            return n;
+        }
+    }
+
+    fprintf(stderr, "Conjunto %ld: utilizacao %g fora da tolerancia apos %d sorteios, aumente tmin, tmax ou tol.\n",
+            k + 1, opcoes->utilizacao, GERADOR_TENTATIVAS);
+
+    return -1;
+}
+
+int gerador_escreve(FILE *fp, const gerador_opcoes_t *opcoes)
+{
+    arena_t *arena;
+    lista_enc_t *lista;
+    tarefa_t *tarefa;
+    no_t *no;
+    long k;
+
+    if (fp == NULL || opcoes == NULL){
+        fprintf(stderr, "gerador_escreve: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    arena = cria_arena(ARENA_BLOCO_PADRAO);
+    for (k = 0; k < opcoes->conjuntos; k++){
+        arena_reinicia(arena);
+        lista = cria_lista_enc_arena(arena);
+        if (gerador_conjunto(opcoes, k, arena, lista) < 0){
+            desaloca_arena(arena);
+            return -1;
+        }
+
+        if (opcoes->conjuntos > 1)
+            fprintf(fp, "C;%ld\n", k + 1);
+        fprintf(fp, "N;%d\nid;C;T\n", opcoes->tarefas);
+        for (no = obter_cabeca(lista); no; no = obtem_proximo(no)){
+            tarefa = (tarefa_t*) obter_dado(no);
+            fprintf(fp, "T%" PRIu32 ";%" PRIu64 ";%" PRIu64 "\n", tarefa_get_id(tarefa), tarefa_get_duracao(tarefa),
+                    tarefa_get_periodo(tarefa));
+        }
+    }
+    desaloca_arena(arena);
+
+    return 0;
+}
+
+// L um inteiro sem sinal que ocupa todo o valor
+static int le_inteiro(const char *valor, uint64_t *n)
+{
+    char *fim;
+
+    if (*valor < '0' || *valor > '9')
+        return -1;
+    *n = strtoull(valor, &fim, 10);
+
+    return *fim == '\0' ? 0 : -1;
+}
+
+int gerador_le_opcoes(const char *texto, gerador_opcoes_t *opcoes)
+{
+    char par[64], *valor, *fim;
+    const char *p, *virgula;
+    uint64_t n = 0;
+    int metodoDado = 0, erro;
+
+    if (texto == NULL || opcoes == NULL){
+        fprintf(stderr, "gerador_le_opcoes: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    opcoes->tarefas = 5;
+    opcoes->utilizacao = 0.7;
+    opcoes->conjuntos = 1;
+    opcoes->periodos = PERIODO_LOG_UNIFORME;
+    opcoes->periodoMin = 10;
+    opcoes->periodoMax = 1000;
+    opcoes->metodo = METODO_UUNIFAST;
+    opcoes->semente = 1;
+    opcoes->tolerancia = 0.01;
+
+    for (p = texto; *p; p = *virgula ? virgula + 1 : virgula){
+        virgula = strchr(p, ',');
+        if (virgula == NULL)
+            virgula = p + strlen(p);
+        if ((size_t) (virgula - p) >= sizeof(par)){
+            fprintf(stderr, "Opcao de geracao invalida `%.*s'.\n", (int) (virgula - p), p);
+            return -1;
+        }
+        memcpy(par, p, virgula - p);
+        par[virgula - p] = '\0';
+
+        valor = strchr(par, '=');
+        if (valor == NULL){
+            fprintf(stderr, "Opcao de geracao invalida `%s', use chave=valor.\n", par);
+            return -1;
+        }
+        *valor++ = '\0';
+
+        erro = 0;
+        if (strcmp(par, "n") == 0){
+            erro = le_inteiro(valor, &n) < 0 || n < 1 || n > GERADOR_MAX_TAREFAS;
+            opcoes->tarefas = (int) n;
+        }else if (strcmp(par, "u") == 0){
+            opcoes->utilizacao = strtod(valor, &fim);
+            erro = *fim != '\0' || fim == valor || !(opcoes->utilizacao > 0);
+        }else if (strcmp(par, "conjuntos") == 0){
+            erro = le_inteiro(valor, &n) < 0 || n < 1 || n > LONG_MAX;
+            opcoes->conjuntos = (long) n;
+        }else if (strcmp(par, "periodos") == 0){
+            if (strcmp(valor, "uniforme") == 0)
+                opcoes->periodos = PERIODO_UNIFORME;
+            else if (strcmp(valor, "log") == 0)
+                opcoes->periodos = PERIODO_LOG_UNIFORME;
+            else if (strcmp(valor, "harmonico") == 0)
+                opcoes->periodos = PERIODO_HARMONICO;
+            else
+                erro = 1;
+        }else if (strcmp(par, "tmin") == 0){
+            erro = le_inteiro(valor, &opcoes->periodoMin) < 0 || opcoes->periodoMin < 1;
+        }else if (strcmp(par, "tmax") == 0){
+            erro = le_inteiro(valor, &opcoes->periodoMax) < 0 || opcoes->periodoMax < 1;
+        }else if (strcmp(par, "metodo") == 0){
+            metodoDado = 1;
+            if (strcmp(valor, "uunifast") == 0)
+                opcoes->metodo = METODO_UUNIFAST;
+            else if (strcmp(valor, "randfixedsum") == 0)
+                opcoes->metodo = METODO_RANDFIXEDSUM;
+            else
+                erro = 1;
+        }else if (strcmp(par, "tol") == 0){
+            opcoes->tolerancia = strtod(valor, &fim);
+            erro = *fim != '\0' || fim == valor || !(opcoes->tolerancia > 0 && opcoes->tolerancia < 1);
+        }else if (strcmp(par, "semente") == 0){
+            erro = le_inteiro(valor, &opcoes->semente) < 0;
+        }else{
+            fprintf(stderr, "Opcao de geracao desconhecida `%s'.\n", par);
+            return -1;
+        }
+
+        if (erro){
+            fprintf(stderr, "Valor invalido `%s' para a opcao de geracao %s.\n", valor, par);
+            return -1;
+        }
+    }
+
+    if (opcoes->periodoMax < opcoes->periodoMin){
+        fprintf(stderr, "Periodos invalidos: tmax deve ser maior ou igual a tmin.\n");
+        return -1;
+    }
+    if (opcoes->utilizacao > opcoes->tarefas){
+        fprintf(stderr, "Utilizacao %g impossivel com %d tarefas de utilizacao ate 1.\n", opcoes->utilizacao,
+                opcoes->tarefas);
+        return -1;
+    }
+    // S  impossvel quando nem todas as duraes de 1 tick com o perodo tmax cabem no alvo; entre
+    // esse limite e n/tmin depende dos perodos sorteados, e o sorteio repetido decide
+    if ((double) opcoes->tarefas/opcoes->periodoMax > opcoes->utilizacao*(1 + opcoes->tolerancia)){
+        fprintf(stderr, "Utilizacao %g menor que a de %d tarefas de duracao 1 com periodo tmax (%g): aumente tmax.\n",
+                opcoes->utilizacao, opcoes->tarefas, (double) opcoes->tarefas/opcoes->periodoMax);
+        return -1;
+    }
+    if (opcoes->utilizacao > 1 && opcoes->metodo == METODO_UUNIFAST){
+        if (metodoDado){
+            fprintf(stderr, "UUniFast nao limita cada utilizacao a 1: com u > 1 use metodo=randfixedsum.\n");
+            return -1;
+        }
+        opcoes->metodo = METODO_RANDFIXEDSUM;
+    }
+
+    return 0;
+}
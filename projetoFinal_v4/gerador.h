@@ -0,0 +1,101 @@
+/** \file gerador.h
+ * \brief   Cabealho do gerador de conjuntos de tarefas sintticos.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ * As utilizaes das tarefas so sorteadas com soma igual  utilizao alvo, por UUniFast (Bini &
+ * Buttazzo) ou RandFixedSum (Stafford), que  uniforme tambm com soma maior que 1 e cada
+ * utilizao limitada a 1. Os perodos seguem uma distribuio uniforme, log-uniforme ou harmnica,
+ * e a durao de cada tarefa  a sua utilizao vezes o perodo, arredondada. Como o arredondamento
+ * desvia a soma do alvo, o conjunto  sorteado de novo at que a utilizao das duraes inteiras
+ * esteja dentro da tolerncia.
+ *
+ * O gerador no tem estado: o conjunto k depende somente das opes e de k, cada um com o seu
+ * gerador pseudoaleatrio derivado da semente. Assim os conjuntos podem ser gerados em qualquer
+ * ordem e por qualquer thread, e o mesmo conjunto  obtido em arquivo ou direto na memria.
+ */
+
+#ifndef GERADOR_H_INCLUDED
+#define GERADOR_H_INCLUDED
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "arena.h"
+#include "lista_enc.h"
+
+#define GERADOR_MAX_TAREFAS    1000    // RandFixedSum usa O(n^2) de memria por conjunto
+#define GERADOR_TENTATIVAS     10000   // Sorteios de um conjunto antes de desistir da tolerncia
+
+/** \enum DISTRIBUICAO
+ * Distribuio dos perodos entre periodoMin e periodoMax, sendo:
+ */
+typedef enum{
+    PERIODO_UNIFORME,       ///< Todos os valores com a mesma probabilidade
+    PERIODO_LOG_UNIFORME,   ///< Cada ordem de grandeza com a mesma probabilidade
+    PERIODO_HARMONICO       ///< periodoMin vezes uma potncia de 2: cada perodo divide os maiores
+} DISTRIBUICAO;
+
+/** \enum METODO
+ * Sorteio das utilizaes com soma fixa, sendo:
+ */
+typedef enum{
+    METODO_UUNIFAST,        ///< UUniFast: somente com utilizao total at 1
+    METODO_RANDFIXEDSUM     ///< RandFixedSum: utilizao total at o nmero de tarefas
+} METODO;
+
+/** \struct gerador_opcoes gerador.h "gerador.h"
+ *   \brief Parmetros dos conjuntos gerados
+ */
+typedef struct gerador_opcoes {
+    int tarefas;                ///< Tarefas em cada conjunto
+    double utilizacao;          ///< Soma de Ci/Ti alvo de cada conjunto
+    long conjuntos;             ///< Nmero de conjuntos
+    DISTRIBUICAO periodos;      ///< Distribuio dos perodos
+    uint64_t periodoMin;        ///< Menor perodo
+    uint64_t periodoMax;        ///< Maior perodo
+    METODO metodo;              ///< Sorteio das utilizaes
+    uint64_t semente;           ///< Semente do gerador pseudoaleatrio
+    double tolerancia;          ///< Erro relativo mximo da utilizao depois de arredondar as duraes
+} gerador_opcoes_t;
+
+/// \brief L as opes do gerador de uma lista "chave=valor" separada por vrgulas.
+/**
+ *  \param texto: por exemplo "n=8,u=0.75,conjuntos=1000,periodos=log,tmin=10,tmax=1000,metodo=uunifast,tol=0.01,semente=42"
+ *  \param opcoes: recebe as opes; as chaves ausentes ficam com o valor padro
+ *  \return 0 se as opes so vlidas, -1 caso contrrio, com a mensagem em stderr
+ *
+ * Chaves: n (padro 5), u (0.7), conjuntos (1), periodos = uniforme, log ou harmonico (log),
+ * tmin (10), tmax (1000), metodo = uunifast ou randfixedsum (uunifast se u <= 1), tol (0.01, erro
+ * relativo da utilizao) e semente (1). Se n/tmax passa de u com a tolerncia, nem as duraes
+ * mnimas de 1 tick com o maior perodo cabem no alvo, e as opes so recusadas.
+ */
+int gerador_le_opcoes(const char *texto, gerador_opcoes_t *opcoes);
+
+/// \brief Gera o conjunto k em uma lista.
+/**
+ *  \param opcoes: opes j validadas por gerador_le_opcoes()
+ *  \param k: ndice do conjunto, de 0 a opcoes->conjuntos-1
+ *  \param arena: arena onde as tarefas, os ns e os vetores auxiliares so alocados
+ *  \param listaTarefas: lista que recebe as tarefas T1 a Tn
+ *  \return nmero de tarefas geradas, ou -1 se nenhum de GERADOR_TENTATIVAS sorteios ficou na tolerncia
+ *  \sa cria_tarefa_arena()
+ */
+int gerador_conjunto(const gerador_opcoes_t *opcoes, long k, arena_t *arena, lista_enc_t *listaTarefas);
+
+/// \brief Escreve todos os conjuntos no formato de entrada "N;"/"id;C;T".
+/**
+ *  \param fp: arquivo de sada
+ *  \param opcoes: opes j validadas por gerador_le_opcoes()
+ *  \return 0, ou -1 se algum conjunto no pde ser gerado
+ *  \sa abre_leitor()
+ *
+ * Com mais de um conjunto cada um  precedido pelo rtulo "C;<k>", k a partir de 1, formando um
+ * arquivo de vrios conjuntos para o modo lote.
+ */
+int gerador_escreve(FILE *fp, const gerador_opcoes_t *opcoes);
+
+#endif // GERADOR_H_INCLUDED
@@ -0,0 +1,431 @@
+/** \file leitor.c
+ * \brief   Leitor de arquivos de tarefas mapeados em memria.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "leitor.h"
+#include "tarefas.h"
+#include "no.h"
+
+#define MAX_CAMPOS  4           // C, T, D e O
+
+// Cabealhos de colunas aceitos, indexados pelo nmero de campos aps o id
+static const char *cabecalhos[MAX_CAMPOS + 1] = { NULL, NULL, "id;C;T", "id;C;T;D", "id;C;T;D;O" };
+static const char *formatos[MAX_CAMPOS + 1] = { NULL, NULL,
+                                                "tarefa invalida, esperado T<id>;<C>;<T>",
+                                                "tarefa invalida, esperado T<id>;<C>;<T>;<D>",
+                                                "tarefa invalida, esperado T<id>;<C>;<T>;<D>;<O>" };
+
+typedef struct {
+    const char *texto;
+    size_t tamanho;
+    void *mapa;         // Regio a ser liberada
+} arquivo_t;
+
+// Mapeia o arquivo inteiro em memria - no Windows o arquivo  lido de uma vez
+static int mapeia(const char *nome, arquivo_t *arq)
+{
+#ifdef _WIN32
+    FILE *fp;
+    long tamanho;
+
+    fp = fopen(nome, "rb");
+    if (fp == NULL)
+        return -1;
+
+    fseek(fp, 0, SEEK_END);
+    tamanho = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    arq->mapa = malloc(tamanho > 0 ? tamanho : 1);
+    if (arq->mapa == NULL || fread(arq->mapa, 1, tamanho, fp) != (size_t) tamanho){
+        free(arq->mapa);
+        fclose(fp);
+        return -1;
+    }
+    fclose(fp);
+
+    arq->texto = arq->mapa;
+    arq->tamanho = tamanho;
+#else
+    struct stat info;
+    int fd;
+
+    fd = open(nome, O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    if (fstat(fd, &info) < 0){
+        close(fd);
+        return -1;
+    }
+
+    arq->tamanho = info.st_size;
+    arq->mapa = NULL;
+    arq->texto = "";
+    if (arq->tamanho > 0){
+        arq->mapa = mmap(NULL, arq->tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (arq->mapa == MAP_FAILED){
+            close(fd);
+            return -1;
+        }
+        madvise(arq->mapa, arq->tamanho, MADV_SEQUENTIAL);
+        arq->texto = arq->mapa;
+    }
+    close(fd);
+#endif
+
+    return 0;
+}
+
+static void desmapeia(arquivo_t *arq)
+{
+#ifdef _WIN32
+    free(arq->mapa);
+#else
+    if (arq->mapa)
+        munmap(arq->mapa, arq->tamanho);
+#endif
+}
+
+// L um inteiro decimal sem sinal; retorna o ponteiro aps os dgitos ou NULL se no houver nmero vlido
+static const char *le_inteiro(const char *p, const char *fim, uint64_t *valor)
+{
+    const char *inicio = p;
+    uint64_t v = 0;
+    unsigned digito;
+
+    while (p < fim && (digito = (unsigned) (*p - '0')) <= 9){
+        if (v > (UINT64_MAX - digito)/10)
+            return NULL;            // Estouro
+        v = v*10 + digito;
+        p++;
+    }
+
+    if (p == inicio)
+        return NULL;
+
+    *valor = v;
+    return p;
+}
+
+// L ";<inteiro>"
+static const char *le_campo(const char *p, const char *fim, uint64_t *valor)
+{
+    if (p >= fim || *p != ';')
+        return NULL;
+
+    return le_inteiro(p + 1, fim, valor);
+}
+
+// Nmero de campos aps o id indicado pelo cabealho de colunas, 0 se a linha no for um cabealho
+static int cabecalho(const char *p, const char *fim)
+{
+    int k;
+
+    for (k = 2; k <= MAX_CAMPOS; k++){
+        if ((size_t) (fim - p) == strlen(cabecalhos[k]) && !memcmp(p, cabecalhos[k], strlen(cabecalhos[k])))
+            return k;
+    }
+
+    return 0;
+}
+
+static void erro(const char *nome, int linha, const char *mensagem)
+{
+    fprintf(stderr, "%s:%d: %s\n", nome, linha, mensagem);
+}
+
+// Interpreta um conjunto de tarefas no texto [p, fim), cuja primeira linha  a linha+1 do arquivo
+static int interpreta(const char *arquivo, const char *p, const char *fim, int linha, arena_t* arena,
+                      lista_enc_t* listaTarefas, int* numTarefas)
+{
+    const char *fimLinha, *proxima;
+    uint64_t id, n, campo[MAX_CAMPOS];
+    tarefa_t *tarefa;
+    int lidas, restantes, declarado, colunas, linhaN, k;
+
+    lidas = 0;
+    declarado = 0;
+    linhaN = 0;
+    colunas = 0;                    // Sem cabealho de colunas prazo e fase so opcionais
+    restantes = -1;                 // Sem cabealho N o arquivo  lido at o fim
+
+    while (p < fim && restantes != 0){
+        linha++;
+
+        fimLinha = memchr(p, '\n', fim - p);
+        if (fimLinha == NULL)
+            fimLinha = fim;
+        proxima = fimLinha + 1;
+
+        // Descarta espaos no incio e "\r", espaos e tabulaes no final
+        while (p < fimLinha && (*p == ' ' || *p == '\t'))
+            p++;
+        while (fimLinha > p && (fimLinha[-1] == '\r' || fimLinha[-1] == ' ' || fimLinha[-1] == '\t'))
+            fimLinha--;
+
+        if (p == fimLinha){
+            p = proxima;
+            continue;
+        }
+
+        if (*p == 'N'){
+            p = le_campo(p + 1, fimLinha, &n);
+            if (p == NULL || p != fimLinha || n > INT32_MAX){
+                erro(arquivo, linha, "numero de tarefas invalido, esperado N;<num>");
+                return -1;
+            }
+            declarado = 1;
+            linhaN = linha;
+            *numTarefas = (int) n;
+            restantes = (int) n;
+        }else if (*p == 'T'){
+            p = le_inteiro(p + 1, fimLinha, &id);
+            for (k = 0; p && p != fimLinha && k < MAX_CAMPOS; k++)
+                p = le_campo(p, fimLinha, &campo[k]);
+            if (p == NULL || p != fimLinha || id > UINT32_MAX || k < 2 || (colunas && k != colunas)){
+                erro(arquivo, linha, formatos[colunas ? colunas : (k >= 2 && k <= MAX_CAMPOS ? k : 2)]);
+                return -1;
+            }
+            if (k < 3)
+                campo[2] = campo[1];        // Sem prazo: D = T
+            if (k < 4)
+                campo[3] = 0;               // Sem fase: chegada em 0
+            if (campo[1] == 0){
+                erro(arquivo, linha, "periodo da tarefa deve ser maior que zero");
+                return -1;
+            }
+            if (campo[2] == 0 || campo[2] > campo[1]){
+                erro(arquivo, linha, "prazo da tarefa deve estar entre 1 e o periodo");
+                return -1;
+            }
+            tarefa = cria_tarefa_arena(arena, (uint32_t) id, campo[0], campo[1]);
+            tarefa_set_prazo(tarefa, campo[2]);
+            tarefa_set_fase(tarefa, campo[3]);
+            add_cauda(listaTarefas, cria_no_arena(arena, (void*) tarefa));
+            lidas++;
+            if (restantes > 0)
+                restantes--;
+        }else if (*p == 'i' && (k = cabecalho(p, fimLinha)) > 0){
+            colunas = k;
+        }else if (*p == 'C' && fimLinha - p > 1 && p[1] == ';'){
+            erro(arquivo, linha, "arquivo com varios conjuntos de tarefas, use o modo lote");
+            return -1;
+        }else{
+            erro(arquivo, linha, "registro desconhecido");
+            return -1;
+        }
+
+        p = proxima;
+    }
+
+    if (lidas == 0){                // Arquivo vazio ou N;0: no h o que analisar nem simular
+        erro(arquivo, linha > 0 ? linha : 1, "nenhuma tarefa");
+        return -1;
+    }
+    if (declarado && lidas < *numTarefas){    // O N do cabealho dimensiona o diagrama: no pode passar das lidas
+        erro(arquivo, linhaN, "menos tarefas que o declarado em N;<num>");
+        return -1;
+    }
+
+    if (!declarado)
+        *numTarefas = lidas;
+
+    return lidas;
+}
+
+int leitor_carrega(const char* arquivo, arena_t* arena, lista_enc_t* listaTarefas, int* numTarefas)
+{
+    arquivo_t arq;
+    int lidas;
+
+    if (arquivo == NULL || arena == NULL || listaTarefas == NULL || numTarefas == NULL){
+        fprintf(stderr, "leitor_carrega: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (mapeia(arquivo, &arq) < 0){
+        perror(arquivo);
+        return -1;
+    }
+
+    lidas = interpreta(arquivo, arq.texto, arq.texto + arq.tamanho, 0, arena, listaTarefas, numTarefas);
+
+    desmapeia(&arq);
+
+    return lidas;
+}
+
+
+struct leitores {
+    arquivo_t arq;
+    const char *nome;
+    const char *p;              // Incio da prxima linha a examinar
+    int linha;                  // Linhas antes de p
+    const char *descartado;     // Fim da regio j devolvida ao sistema
+};
+
+// Verifica se a linha [p, fimLinha)  o rtulo de um conjunto, "C;<rotulo>"
+static int rotulo(const char *p, const char *fimLinha)
+{
+    while (p < fimLinha && (*p == ' ' || *p == '\t'))
+        p++;
+
+    return fimLinha - p > 1 && p[0] == 'C' && p[1] == ';';
+}
+
+leitor_t *abre_leitor(const char* arquivo)
+{
+    leitor_t *p;
+
+    if (arquivo == NULL){
+        fprintf(stderr, "abre_leitor: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    p = malloc(sizeof(leitor_t));
+    if (p == NULL){
+        perror("abre_leitor:");
+        exit(EXIT_FAILURE);
+    }
+
+    if (mapeia(arquivo, &p->arq) < 0){
+        perror(arquivo);
+        free(p);
+        return NULL;
+    }
+
+    p->nome = arquivo;
+    p->p = p->arq.texto;
+    p->linha = 0;
+    p->descartado = p->arq.texto;
+
+    return p;
+}
+
+int leitor_proximo(leitor_t* leitor, leitor_bloco_t* bloco)
+{
+    const char *fim, *fimLinha, *q;
+    int rotulado;
+
+    if (leitor == NULL || bloco == NULL){
+        fprintf(stderr, "leitor_proximo: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fim = leitor->arq.texto + leitor->arq.tamanho;
+
+    while (leitor->p < fim){
+        fimLinha = memchr(leitor->p, '\n', fim - leitor->p);
+        if (fimLinha == NULL)
+            fimLinha = fim;
+
+        bloco->rotulo = "";
+        bloco->tamanhoRotulo = 0;
+        rotulado = rotulo(leitor->p, fimLinha);
+        if (rotulado){
+            q = memchr(leitor->p, ';', fimLinha - leitor->p) + 1;
+            while (q < fimLinha && (*q == ' ' || *q == '\t'))
+                q++;
+            while (fimLinha > q && (fimLinha[-1] == '\r' || fimLinha[-1] == ' ' || fimLinha[-1] == '\t'))
+                fimLinha--;
+            bloco->rotulo = q;
+            bloco->tamanhoRotulo = (int) (fimLinha - q);
+            leitor->p = memchr(leitor->p, '\n', fim - leitor->p);
+            leitor->p = leitor->p ? leitor->p + 1 : fim;
+            leitor->linha++;
+        }
+
+        // O bloco vai at a prxima linha de rtulo ou o fim do arquivo
+        bloco->texto = leitor->p;
+        bloco->linha = leitor->linha;
+        while (leitor->p < fim){
+            fimLinha = memchr(leitor->p, '\n', fim - leitor->p);
+            if (fimLinha == NULL)
+                fimLinha = fim;
+            if (rotulo(leitor->p, fimLinha))
+                break;
+            leitor->p = fimLinha < fim ? fimLinha + 1 : fim;
+            leitor->linha++;
+        }
+        bloco->tamanho = leitor->p - bloco->texto;
+
+        if (rotulado)
+            return 1;
+
+        // Texto antes do primeiro rtulo: s  um conjunto, sem nome, se no estiver em branco
+        for (q = bloco->texto; q < leitor->p; q++)
+            if (*q != ' ' && *q != '\t' && *q != '\r' && *q != '\n')
+                return 1;
+    }
+
+    return 0;
+}
+
+int leitor_carrega_bloco(leitor_t* leitor, const leitor_bloco_t* bloco, arena_t* arena, lista_enc_t* listaTarefas,
+                         int* numTarefas)
+{
+    if (leitor == NULL || bloco == NULL || arena == NULL || listaTarefas == NULL || numTarefas == NULL){
+        fprintf(stderr, "leitor_carrega_bloco: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return interpreta(leitor->nome, bloco->texto, bloco->texto + bloco->tamanho, bloco->linha, arena, listaTarefas,
+                      numTarefas);
+}
+
+void leitor_descarta(leitor_t* leitor)
+{
+#ifndef _WIN32
+    const char *limite;
+    long pagina;
+
+    if (leitor == NULL){
+        fprintf(stderr, "leitor_descarta: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Somente pginas inteiras antes do prximo bloco: o mapa comea no incio de uma pgina
+    pagina = sysconf(_SC_PAGESIZE);
+    if (leitor->arq.mapa == NULL || pagina <= 0)
+        return;
+    limite = leitor->arq.texto + (size_t) (leitor->p - leitor->arq.texto)/pagina*pagina;
+    if (limite > leitor->descartado){
+        madvise((void*) leitor->descartado, limite - leitor->descartado, MADV_DONTNEED);
+        leitor->descartado = limite;
+    }
+#else
+    (void) leitor;      // O arquivo inteiro j est na memria
+#endif
+}
+
+void fecha_leitor(leitor_t* leitor)
+{
+    if (leitor == NULL){
+        fprintf(stderr, "fecha_leitor: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    desmapeia(&leitor->arq);
+    free(leitor);
+}
@@ -0,0 +1,106 @@
+/** \file leitor.h
+ * \brief   Cabealho do leitor de arquivos de tarefas.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#ifndef LEITOR_H_INCLUDED
+#define LEITOR_H_INCLUDED
+
+#include <stddef.h>
+
+#include "arena.h"
+#include "lista_enc.h"
+
+/// \brief Carrega um arquivo de tarefas para uma lista.
+/**
+ *  \param arquivo: caminho do arquivo de entrada
+ *  \param arena: arena onde as tarefas e os ns so alocados
+ *  \param listaTarefas: lista, normalmente da mesma arena, que recebe as tarefas na ordem do arquivo
+ *  \param numTarefas: recebe o N do cabealho, ou o nmero de tarefas lidas caso no haja cabealho
+ *  \return nmero de tarefas lidas, ou -1 em caso de erro
+ *  \sa cria_lista_enc_arena(), cria_tarefa_arena()
+ *
+ * O arquivo  mapeado em memria e lido em uma nica passagem, sem cpias nem limite de tamanho
+ * de linha. So aceitos os registros "N;<num>", o cabealho "id;C;T" e as tarefas "T<id>;<C>;<T>";
+ * com o cabealho "id;C;T;D" as tarefas trazem tambm o prazo, "T<id>;<C>;<T>;<D>", com 0 < D <= T,
+ * e com "id;C;T;D;O" tambm a fase, "T<id>;<C>;<T>;<D>;<O>". Sem cabealho de colunas os trs
+ * formatos de tarefa so aceitos; sem prazo vale D = T e sem fase a primeira chegada  em 0. Linhas
+ * vazias e finais de linha "\r\n" so ignorados. Depois de N tarefas o restante do arquivo no 
+ * lido, e um arquivo com menos de N tarefas  um erro. Um conjunto sem tarefas, vazio ou com "N;0",
+ * tambm  um erro. Erros so informados em stderr com o nmero da linha. Uma linha de rtulo
+ * "C;<rotulo>"  um erro: arquivos de vrios conjuntos so lidos por abre_leitor().
+ */
+int leitor_carrega(const char* arquivo, arena_t* arena, lista_enc_t* listaTarefas, int* numTarefas);
+
+/** \struct leitor_bloco leitor.h "leitor.h"
+ *   \brief Trecho de um arquivo de vrios conjuntos que contm um conjunto de tarefas
+ */
+typedef struct leitor_bloco {
+    const char *rotulo;         ///< Rtulo do conjunto, sem terminador nulo
+    int tamanhoRotulo;          ///< Caracteres do rtulo, 0 se o conjunto no tem nome
+    const char *texto;          ///< Incio do conjunto no arquivo mapeado
+    size_t tamanho;             ///< Tamanho do conjunto em bytes
+    int linha;                  ///< Linhas do arquivo antes do conjunto, para as mensagens de erro
+} leitor_bloco_t;
+
+typedef struct leitores leitor_t;
+
+/// \brief Abre um arquivo de vrios conjuntos de tarefas para leitura em sequncia.
+/**
+ *  \param arquivo: caminho do arquivo, que deve continuar vlido at fecha_leitor()
+ *  \return Um ponteiro alocado do tipo leitor_t, ou NULL em caso de erro
+ *  \sa leitor_proximo(), fecha_leitor()
+ *
+ * Cada conjunto comea em uma linha de rtulo "C;<rotulo>" e vai at o prximo rtulo ou o fim do
+ * arquivo, com os mesmos registros de leitor_carrega(): "N;<num>", o cabealho de colunas e as
+ * tarefas, que valem somente para o seu conjunto. Texto antes do primeiro rtulo  um conjunto sem nome,
+ * portanto um arquivo comum  um arquivo de um s conjunto.
+ */
+leitor_t* abre_leitor(const char* arquivo);
+
+/// \brief Localiza o prximo conjunto do arquivo, sem interpret-lo.
+/**
+ *  \param leitor: ponteiro do leitor
+ *  \param bloco: recebe o rtulo e o trecho do conjunto, vlidos at fecha_leitor()
+ *  \return 1 se encontrou um conjunto, 0 no fim do arquivo
+ *  \sa leitor_carrega_bloco()
+ *
+ * Somente os incios de linha so examinados; as tarefas so lidas depois, por leitor_carrega_bloco().
+ */
+int leitor_proximo(leitor_t* leitor, leitor_bloco_t* bloco);
+
+/// \brief Carrega as tarefas de um conjunto localizado por leitor_proximo().
+/**
+ *  \param leitor: ponteiro do leitor
+ *  \param bloco: conjunto a carregar
+ *  \param arena: arena onde as tarefas e os ns so alocados
+ *  \param listaTarefas: lista que recebe as tarefas na ordem do arquivo
+ *  \param numTarefas: recebe o N do conjunto, ou o nmero de tarefas lidas caso no haja cabealho
+ *  \return nmero de tarefas lidas, ou -1 em caso de erro
+ *  \sa leitor_carrega()
+ *
+ * Somente l o arquivo mapeado: conjuntos diferentes podem ser carregados ao mesmo tempo por
+ * threads diferentes, cada uma com a sua arena.
+ */
+int leitor_carrega_bloco(leitor_t* leitor, const leitor_bloco_t* bloco, arena_t* arena, lista_enc_t* listaTarefas,
+                         int* numTarefas);
+
+/// \brief Devolve ao sistema as pginas do arquivo anteriores ao prximo conjunto.
+/**
+ *  \param leitor: ponteiro do leitor
+ *  \return vazio
+ *
+ * S deve ser chamada quando nenhum conjunto j entregue estiver em uso, nem os seus rtulos. Assim a
+ * memria ocupada pelo arquivo no cresce com o nmero de conjuntos lidos.
+ */
+void leitor_descarta(leitor_t* leitor);
+
+/// \brief Fecha o arquivo e libera o leitor.
+void fecha_leitor(leitor_t* leitor);
+
+#endif // LEITOR_H_INCLUDED
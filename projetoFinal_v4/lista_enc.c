@@ -23,6 +23,7 @@ struct listas_enc {
     no_t *cabeca;
     no_t *cauda;
     int tamanho;
+    arena_t *arena;     // Arena dos ns, NULL quando alocados com malloc
 };
 
 //cria uma lista vazia
@@ -37,10 +38,33 @@ lista_enc_t *cria_lista_enc (void) {
     p->cabeca = NULL;
     p->cauda = NULL;
     p->tamanho = 0;
+    p->arena = NULL;
 
     return p;
 }
 
+lista_enc_t *cria_lista_enc_arena(arena_t *arena)
+{
+    lista_enc_t *p = arena_aloca(arena, sizeof(lista_enc_t));
+
+    p->cabeca = NULL;
+    p->cauda = NULL;
+    p->tamanho = 0;
+    p->arena = arena;
+
+    return p;
+}
+
+arena_t *lista_obter_arena(lista_enc_t *lista)
+{
+    if (lista == NULL){
+        fprintf(stderr,"lista_obter_arena: ponteiros invalidos");
+        exit(EXIT_FAILURE);
+    }
+
+    return lista->arena;
+}
+
 void add_cauda(lista_enc_t *lista, no_t* elemento)
 {
     if (lista == NULL || elemento == NULL){
@@ -182,6 +206,89 @@ void swap_nos(lista_enc_t *lista, no_t* no)
     liga_nos(noSeg, no);
 }
 
+// Intercala duas sequncias ordenadas terminadas em NULL, preferindo a primeira nos empates
+static no_t *intercala(no_t *a, no_t *b, int (*compara)(void *a, void *b))
+{
+    no_t *cabeca = NULL;
+    no_t *cauda = NULL;
+    no_t *escolhido;
+
+    while (a && b){
+        if (compara(obter_dado(b), obter_dado(a)) < 0){
+            escolhido = b;
+            b = obtem_proximo(b);
+        }else{
+            escolhido = a;
+            a = obtem_proximo(a);
+        }
+
+        if (cauda)
+            liga_nos(cauda, escolhido);
+        else{
+            cabeca = escolhido;
+            desliga_no_anterior(cabeca);
+        }
+        cauda = escolhido;
+    }
+
+    // O restante j est encadeado e termina em NULL
+    escolhido = a ? a : b;
+    if (escolhido){
+        if (cauda)
+            liga_nos(cauda, escolhido);
+        else{
+            cabeca = escolhido;
+            desliga_no_anterior(cabeca);
+        }
+    }
+
+    return cabeca;
+}
+
+static no_t *ordena_sequencia(no_t *cabeca, int tamanho, int (*compara)(void *a, void *b))
+{
+    no_t *meio;
+    no_t *segunda;
+    int i;
+
+    if (tamanho < 2)
+        return cabeca;
+
+    // Divide a sequncia ao meio
+    meio = cabeca;
+    for (i = 1; i < tamanho/2; i++)
+        meio = obtem_proximo(meio);
+
+    segunda = obtem_proximo(meio);
+    desliga_no_proximo(meio);
+    desliga_no_anterior(segunda);
+
+    cabeca = ordena_sequencia(cabeca, tamanho/2, compara);
+    segunda = ordena_sequencia(segunda, tamanho - tamanho/2, compara);
+
+    return intercala(cabeca, segunda, compara);
+}
+
+void ordena_lista(lista_enc_t *lista, int (*compara)(void *a, void *b))
+{
+    no_t *no;
+
+    if (lista == NULL || compara == NULL){
+        fprintf(stderr,"ordena_lista: ponteiros invalidos");
+        exit(EXIT_FAILURE);
+    }
+
+    if (lista->tamanho < 2)
+        return;
+
+    lista->cabeca = ordena_sequencia(lista->cabeca, lista->tamanho, compara);
+
+    no = lista->cabeca;
+    while (obtem_proximo(no))
+        no = obtem_proximo(no);
+    lista->cauda = no;
+}
+
 no_t *remover_cauda(lista_enc_t *lista)
 {
 	no_t *anterior;
@@ -281,7 +388,8 @@ void *remover_no(lista_enc_t *lista, no_t *no_removido)
 				liga_nos(anterior, proximo);
 				lista->tamanho--;
 			}
-			free(meu_no);
+			if (lista->arena == NULL)
+				free(meu_no);
 			break;
 		}
 		meu_no = obtem_proximo(meu_no);
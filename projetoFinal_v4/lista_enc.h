@@ -12,10 +12,15 @@
 #define LISTA_ENC_H_INCLUDED
 
 #include "no.h"
+#include "arena.h"
 
 typedef struct listas_enc lista_enc_t;
 
 lista_enc_t *cria_lista_enc(void);
+/* Lista alocada na arena, cujos ns tambm pertencem  arena.
+ * Nada  liberado individualmente: a arena libera tudo de uma vez */
+lista_enc_t *cria_lista_enc_arena(arena_t *arena);
+arena_t *lista_obter_arena(lista_enc_t *lista);
 void add_cauda(lista_enc_t *lista, no_t* elemento);
 no_t *obter_cabeca(lista_enc_t *lista);
 int lista_vazia(lista_enc_t *lista);
@@ -29,6 +34,10 @@ void imprimi_lista_tras (lista_enc_t *lista);
 int tamanho_lista(lista_enc_t *lista);
 void swap_nos(lista_enc_t *lista, no_t* no);
 
+/* Ordena a lista de forma estvel (merge sort), religando os ns - O(n log n)
+ * compara(a, b) recebe os dados de dois ns e retorna < 0, 0 ou > 0 */
+void ordena_lista(lista_enc_t *lista, int (*compara)(void *a, void *b));
+
 /* Retorna o dado de um no removido*
  * no_removido  liberado da memoria  */
 void *remover_no(lista_enc_t *lista, no_t *no_removido);
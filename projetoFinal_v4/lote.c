@@ -0,0 +1,427 @@
+/** \file lote.c
+ * \brief   Avaliao de conjuntos de tarefas em lote.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "lote.h"
+#include "executor.h"
+#include "arena.h"
+#include "lista_enc.h"
+#include "tarefas.h"
+#include "tabela.h"
+#include "escalonador.h"
+#include "escritor.h"
+#include "analise.h"
+#include "leitor.h"
+#include "gerador.h"
+
+static const char *vereditos[] = { "ESCALONAVEL", "NAO_ESCALONAVEL", "INCONCLUSIVO" };
+
+// Um conjunto do lote: entrada do trabalho e, depois dele, o resultado
+typedef struct {
+    char *caminho;                  // Arquivo do conjunto, NULL se ele  um bloco do leitor ou gerado
+    leitor_t *leitor;
+    leitor_bloco_t bloco;
+    const gerador_opcoes_t *gerador;        // Opes do gerador, NULL se o conjunto vem de arquivo
+    const char *nome;               // Nome do arquivo dentro do diretrio ou rtulo do bloco, sem terminador
+    int tamanhoNome;                // 0 para um bloco sem rtulo, identificado pela posio
+    long indice;                    // Posio do conjunto no lote, a partir de 1
+    const lote_opcoes_t *opcoes;
+    arena_t **arenas;               // Arena de cada trabalhadora do executor
+    const char *erro;               // Motivo de o conjunto no ter sido avaliado, NULL se foi
+    int tarefas;
+    double utilizacao;
+    VEREDITO veredito;
+    int simulado;
+    uint64_t fim;
+    uint64_t perdas;
+    uint64_t preempcoes;
+    uint64_t migracoes;
+    double ociosa;
+} conjunto_t;
+
+// Soma os contadores de uma tabela simulada ao resultado do conjunto
+static void acumula(conjunto_t *c, tabela_t *tabela, uint64_t fim)
+{
+    int i;
+
+    for (i = 0; i < tabela->n; i++){
+        c->perdas += tabela->perdas[i];
+        c->preempcoes += tabela->preempcoes[i];
+        c->migracoes += tabela->migracoes[i];
+    }
+    if (fim > c->fim)
+        c->fim = fim;
+}
+
+static void simula(conjunto_t *c, lista_enc_t *lista, particao_t *particao)
+{
+    const lote_opcoes_t *o = c->opcoes;
+    uint64_t hiperPeriodo, horizonte, maiorFase, fim;
+    double ociosa;
+    escritor_t *escritor;
+    tabela_t *tabela;
+    int k;
+
+    hiperPeriodo = tarefas_calcMMC(lista);
+    horizonte = hiperPeriodo;
+    if (hiperPeriodo != MMC_ESTOURO && (maiorFase = tarefas_maior_fase(lista)) > 0)
+        horizonte = hiperPeriodo > (UINT64_MAX - maiorFase)/2 ? MMC_ESTOURO : maiorFase + 2*hiperPeriodo;
+    if (o->limite && (horizonte == MMC_ESTOURO || horizonte > o->limite))
+        horizonte = o->limite;
+    if (horizonte == MMC_ESTOURO){
+        c->erro = "HIPERPERIODO_ESTOURO";
+        return;
+    }
+
+    escritor = cria_escritor(NULL, NULL, 0);       // S as estatsticas interessam
+    c->simulado = 1;
+
+    if (particao){
+        ociosa = 0;
+        for (k = 0; k < o->nucleos; k++){
+            if (tamanho_lista(particao_lista(particao, k)) == 0){
+                ociosa += 1.0;
+                continue;
+            }
+            ordena_tarefas(particao_lista(particao, k));
+            tabela = cria_tabela(particao_lista(particao, k));
+            fim = escalonador_simula(tabela, o->politica, horizonte, hiperPeriodo, o->falhaRapida, c->tarefas + k,
+                                     escritor);
+            acumula(c, tabela, fim);
+            ociosa += 1.0 - (double) tabela->tempoOcupado/tabela->tempoSimulado;
+            desaloca_tabela(tabela);
+        }
+        c->ociosa = ociosa/o->nucleos;          // Mdia dos ncleos, cada um no intervalo que simulou
+    }else{
+        ordena_tarefas(lista);
+        tabela = cria_tabela(lista);
+        if (o->nucleos > 1)
+            fim = escalonador_simula_global(tabela, o->politica, horizonte, hiperPeriodo, o->falhaRapida, c->tarefas,
+                                            o->nucleos, escritor);
+        else
+            fim = escalonador_simula(tabela, o->politica, horizonte, hiperPeriodo, o->falhaRapida, c->tarefas, escritor);
+        acumula(c, tabela, fim);
+        c->ociosa = 1.0 - (double) tabela->tempoOcupado/((double) tabela->tempoSimulado*o->nucleos);
+        desaloca_tabela(tabela);
+    }
+
+    finaliza_escritor(escritor);
+}
+
+// Trabalho do executor: l, analisa e simula um conjunto usando somente a arena da trabalhadora
+static void avalia(void *arg, int trabalhador)
+{
+    conjunto_t *c = arg;
+    const lote_opcoes_t *o = c->opcoes;
+    arena_t *arena = c->arenas[trabalhador];
+    lista_enc_t *lista;
+    particao_t *particao = NULL;
+    int numTarefas, rejeitadas = 0;
+
+    arena_reinicia(arena);          // Descarta o conjunto anterior desta trabalhadora
+    lista = cria_lista_enc_arena(arena);
+
+    if (c->gerador)
+        c->tarefas = gerador_conjunto(c->gerador, c->indice - 1, arena, lista);
+    else if (c->leitor)
+        c->tarefas = leitor_carrega_bloco(c->leitor, &c->bloco, arena, lista, &numTarefas);
+    else
+        c->tarefas = leitor_carrega(c->caminho, arena, lista, &numTarefas);
+    if (c->tarefas < 0){
+        c->erro = c->gerador ? "ERRO_GERACAO" : "ERRO_LEITURA";
+        return;
+    }
+
+    if (o->politica == &politica_edf)
+        c->veredito = analise_utilizacao_edf(lista, &c->utilizacao);
+    else
+        c->veredito = analise_utilizacao(lista, &c->utilizacao);
+
+    if (o->nucleos > 1 && o->global){
+        c->veredito = analise_global(lista, o->nucleos, o->politica, &c->utilizacao);
+    }else if (o->nucleos > 1){
+        particao = cria_particao(arena, lista, o->nucleos, o->heuristica, o->admissao, o->politica);
+        rejeitadas = tamanho_lista(particao_rejeitadas(particao));
+        if (rejeitadas == 0)
+            c->veredito = ESCALONAVEL;
+        else if (c->utilizacao > o->nucleos + ANALISE_TOLERANCIA)
+            c->veredito = NAO_ESCALONAVEL;
+        else
+            c->veredito = INCONCLUSIVO;
+    }else if (o->analisar && c->veredito == INCONCLUSIVO){
+        c->veredito = analise_exata(lista, o->politica, NULL);
+    }
+
+    if (o->analisar || rejeitadas || c->tarefas == 0)
+        return;
+
+    simula(c, lista, particao);
+}
+
+static int compara_nomes(const void *a, const void *b)
+{
+    return strcmp(((const conjunto_t*) a)->nome, ((const conjunto_t*) b)->nome);
+}
+
+// Lista os arquivos comuns do diretrio, exceto os ocultos
+static conjunto_t *lista_diretorio(const char *diretorio, int *numConjuntos)
+{
+    DIR *dir;
+    struct dirent *entrada;
+    struct stat info;
+    conjunto_t *conjuntos = NULL, *novos;
+    size_t tamanhoDiretorio = strlen(diretorio);
+    int capacidade = 0, n = 0;
+    char *caminho;
+
+    dir = opendir(diretorio);
+    if (dir == NULL)
+        return NULL;
+
+    while ((entrada = readdir(dir)) != NULL){
+        if (entrada->d_name[0] == '.')
+            continue;
+
+        caminho = malloc(tamanhoDiretorio + strlen(entrada->d_name) + 2);
+        if (caminho == NULL){
+            perror("lote_executa:");
+            exit(EXIT_FAILURE);
+        }
+        sprintf(caminho, "%s/%s", diretorio, entrada->d_name);
+        if (stat(caminho, &info) < 0 || !S_ISREG(info.st_mode)){
+            free(caminho);
+            continue;
+        }
+
+        if (n == capacidade){
+            capacidade = capacidade ? 2*capacidade : 64;
+            novos = realloc(conjuntos, capacidade*sizeof(conjunto_t));
+            if (novos == NULL){
+                perror("lote_executa:");
+                exit(EXIT_FAILURE);
+            }
+            conjuntos = novos;
+        }
+        memset(&conjuntos[n], 0, sizeof(conjunto_t));
+        conjuntos[n].caminho = caminho;
+        conjuntos[n].nome = caminho + tamanhoDiretorio + 1;
+        conjuntos[n].tamanhoNome = (int) strlen(conjuntos[n].nome);
+        n++;
+    }
+    closedir(dir);
+
+    if (conjuntos == NULL){                 // Diretrio vazio: lista vlida sem conjuntos
+        conjuntos = malloc(sizeof(conjunto_t));
+        if (conjuntos == NULL){
+            perror("lote_executa:");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    *numConjuntos = n;
+    return conjuntos;
+}
+
+static void imprime_cabecalho(FILE *fp)
+{
+    fprintf(fp, "conjunto;tarefas;utilizacao;veredito;fim;perdas;preempcoes;migracoes;ociosa\n");
+}
+
+static void imprime_conjunto(FILE *fp, const conjunto_t *c)
+{
+    if (c->tamanhoNome > 0)
+        fprintf(fp, "%.*s;", c->tamanhoNome, c->nome);
+    else
+        fprintf(fp, "%ld;", c->indice);
+
+    if (c->erro && c->tarefas < 0){
+        fprintf(fp, "-;-;%s;-;-;-;-;-\n", c->erro);
+        return;
+    }
+
+    fprintf(fp, "%d;%.6f;%s;", c->tarefas, c->utilizacao, c->erro ? c->erro : vereditos[c->veredito]);
+    if (c->simulado)
+        fprintf(fp, "%" PRIu64 ";%" PRIu64 ";%" PRIu64 ";%" PRIu64 ";%.6f\n", c->fim, c->perdas, c->preempcoes,
+                c->migracoes, c->ociosa);
+    else
+        fprintf(fp, "-;-;-;-;-\n");
+}
+
+// Um conjunto por arquivo do diretrio: todos so submetidos de uma vez
+static int lote_diretorio(const char *diretorio, const lote_opcoes_t *opcoes, executor_t *executor, arena_t **arenas,
+                          FILE *fp)
+{
+    conjunto_t *conjuntos;
+    int numConjuntos, i;
+
+    conjuntos = lista_diretorio(diretorio, &numConjuntos);
+    if (conjuntos == NULL){
+        perror(diretorio);
+        return -1;
+    }
+    qsort(conjuntos, numConjuntos, sizeof(conjunto_t), compara_nomes);
+
+    // Cada trabalho escreve somente no seu conjunto: a tabela sai depois, na ordem dos nomes
+    for (i = 0; i < numConjuntos; i++){
+        conjuntos[i].indice = i + 1;
+        conjuntos[i].opcoes = opcoes;
+        conjuntos[i].arenas = arenas;
+        executor_submete(executor, avalia, &conjuntos[i]);
+    }
+    executor_espera(executor);
+
+    imprime_cabecalho(fp);
+    for (i = 0; i < numConjuntos; i++){
+        imprime_conjunto(fp, &conjuntos[i]);
+        free(conjuntos[i].caminho);
+    }
+    free(conjuntos);
+
+    return numConjuntos;
+}
+
+// Arquivo de vrios conjuntos ou conjuntos gerados: avaliados em janelas, para que nem os resultados nem
+// as pginas do arquivo se acumulem
+static long lote_janelas(leitor_t *leitor, const gerador_opcoes_t *gerador, const lote_opcoes_t *opcoes,
+                         executor_t *executor, arena_t **arenas, FILE *fp)
+{
+    conjunto_t *conjuntos;
+    long total;
+    int janela, n, i;
+
+    janela = LOTE_JANELA*executor_trabalhadores(executor);
+    conjuntos = malloc(janela*sizeof(conjunto_t));
+    if (conjuntos == NULL){
+        perror("lote_executa:");
+        exit(EXIT_FAILURE);
+    }
+
+    imprime_cabecalho(fp);
+    total = 0;
+    do{
+        for (n = 0; n < janela; n++){
+            memset(&conjuntos[n], 0, sizeof(conjunto_t));
+            if (gerador){
+                if (total + n >= gerador->conjuntos)
+                    break;
+                conjuntos[n].gerador = gerador;
+            }else{
+                if (!leitor_proximo(leitor, &conjuntos[n].bloco))
+                    break;
+                conjuntos[n].leitor = leitor;
+                conjuntos[n].nome = conjuntos[n].bloco.rotulo;
+                conjuntos[n].tamanhoNome = conjuntos[n].bloco.tamanhoRotulo;
+            }
+            conjuntos[n].indice = total + n + 1;
+            conjuntos[n].opcoes = opcoes;
+            conjuntos[n].arenas = arenas;
+            executor_submete(executor, avalia, &conjuntos[n]);
+        }
+        executor_espera(executor);
+
+        for (i = 0; i < n; i++)
+            imprime_conjunto(fp, &conjuntos[i]);
+        if (leitor)
+            leitor_descarta(leitor);        // Nenhum conjunto da janela est mais em uso
+        total += n;
+    }while (n == janela);
+
+    free(conjuntos);
+
+    return total;
+}
+
+// Cria o executor e uma arena por trabalhadora
+static executor_t *prepara(const lote_opcoes_t *opcoes, arena_t ***arenas)
+{
+    executor_t *executor;
+    int trabalhadores, i;
+
+    executor = cria_executor(opcoes->trabalhadores);
+    trabalhadores = executor_trabalhadores(executor);
+    *arenas = malloc(trabalhadores*sizeof(arena_t*));
+    if (*arenas == NULL){
+        perror("lote_executa:");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < trabalhadores; i++)
+        (*arenas)[i] = cria_arena(ARENA_BLOCO_PADRAO);
+
+    return executor;
+}
+
+static void finaliza(executor_t *executor, arena_t **arenas)
+{
+    int trabalhadores, i;
+
+    trabalhadores = executor_trabalhadores(executor);
+    finaliza_executor(executor);
+    for (i = 0; i < trabalhadores; i++)
+        desaloca_arena(arenas[i]);
+    free(arenas);
+}
+
+int lote_executa(const char *caminho, const lote_opcoes_t *opcoes, FILE *fp)
+{
+    struct stat info;
+    executor_t *executor;
+    arena_t **arenas;
+    leitor_t *leitor;
+    long ret;
+
+    if (caminho == NULL || opcoes == NULL || fp == NULL){
+        fprintf(stderr, "lote_executa: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (stat(caminho, &info) < 0){
+        perror(caminho);
+        return -1;
+    }
+
+    if (S_ISDIR(info.st_mode)){
+        executor = prepara(opcoes, &arenas);
+        ret = lote_diretorio(caminho, opcoes, executor, arenas, fp);
+    }else{
+        leitor = abre_leitor(caminho);
+        if (leitor == NULL)
+            return -1;
+        executor = prepara(opcoes, &arenas);
+        ret = lote_janelas(leitor, NULL, opcoes, executor, arenas, fp);
+        fecha_leitor(leitor);
+    }
+    finaliza(executor, arenas);
+
+    return (int) ret;
+}
+
+long lote_executa_gerador(const gerador_opcoes_t *gerador, const lote_opcoes_t *opcoes, FILE *fp)
+{
+    executor_t *executor;
+    arena_t **arenas;
+    long ret;
+
+    if (gerador == NULL || opcoes == NULL || fp == NULL){
+        fprintf(stderr, "lote_executa_gerador: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    executor = prepara(opcoes, &arenas);
+    ret = lote_janelas(NULL, gerador, opcoes, executor, arenas, fp);
+    finaliza(executor, arenas);
+
+    return ret;
+}
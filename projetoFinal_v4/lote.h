@@ -0,0 +1,77 @@
+/** \file lote.h
+ * \brief   Cabealho da avaliao de conjuntos de tarefas em lote.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ * Os conjuntos de tarefas independentes vm de um diretrio, um por arquivo, ou de um arquivo de
+ * vrios conjuntos rotulados (abre_leitor()). Eles so distribudos entre as threads de um executor
+ * com roubo de trabalho, e cada thread l, analisa e simula o conjunto com a sua prpria arena, sem
+ * Diagrama de Gannt e sem estado compartilhado. O resultado de todos os conjuntos sai em uma s
+ * tabela separada por ';', na ordem dos nomes dos arquivos ou na ordem do arquivo.
+ */
+
+#ifndef LOTE_H_INCLUDED
+#define LOTE_H_INCLUDED
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "politica.h"
+#include "particao.h"
+#include "gerador.h"
+
+#define LOTE_JANELA     256     // Conjuntos em andamento por thread na leitura de um arquivo de vrios conjuntos
+
+/** \struct lote_opcoes lote.h "lote.h"
+ *   \brief Opes aplicadas a todos os conjuntos do lote, as mesmas da linha de comando
+ */
+typedef struct lote_opcoes {
+    const politica_t *politica; ///< politica_rm ou politica_edf
+    int nucleos;                ///< Nmero de ncleos
+    int global;                 ///< Com nucleos > 1: escalonamento global em vez de particionado
+    HEURISTICA heuristica;      ///< Heurstica do particionado
+    ADMISSAO admissao;          ///< Teste de admisso do particionado
+    int analisar;               ///< Somente anlise, sem simulao
+    int falhaRapida;            ///< Simulao termina na primeira perda de prazo
+    uint64_t limite;            ///< ltimo instante simulado quando o intervalo  maior ou no cabe em 64 bits, 0 sem limite
+    int trabalhadores;          ///< Threads do executor, 0 para uma por processador
+} lote_opcoes_t;
+
+/// \brief Avalia todos os conjuntos de tarefas de um diretrio ou de um arquivo de vrios conjuntos.
+/**
+ *  \param caminho: diretrio com um arquivo de tarefas por conjunto, ou arquivo de vrios conjuntos
+ *  \param opcoes: opes de anlise e simulao
+ *  \param fp: arquivo que recebe a tabela de resultados
+ *  \return nmero de conjuntos avaliados, ou -1 se o caminho no pde ser lido
+ *  \sa leitor_carrega(), abre_leitor(), cria_executor()
+ *
+ * O arquivo de vrios conjuntos  percorrido em janelas de LOTE_JANELA conjuntos por thread: a
+ * janela seguinte s  lida depois que a tabela da anterior foi escrita e suas pginas devolvidas
+ * (leitor_descarta()), portanto a memria no cresce com o nmero de conjuntos do arquivo. Um
+ * conjunto sem rtulo  identificado na tabela pela sua posio.
+ *
+ * Uma linha de cabealho e uma linha por conjunto com o nmero de tarefas, a utilizao, o veredito
+ * do teste de escalonabilidade e, se houve simulao, o instante final, as perdas de prazo, as
+ * preempes, as migraes e a frao ociosa. Com opcoes->analisar o veredito  o do teste exato
+ * (QPA ou RTA) quando o de utilizao  inconclusivo. Campos sem valor so "-", e um conjunto que
+ * no pde ser avaliado tem o motivo no lugar do veredito.
+ */
+int lote_executa(const char *caminho, const lote_opcoes_t *opcoes, FILE *fp);
+
+/// \brief Avalia conjuntos gerados direto na memria, sem arquivo.
+/**
+ *  \param gerador: opes do gerador, j validadas por gerador_le_opcoes()
+ *  \param opcoes: opes de anlise e simulao
+ *  \param fp: arquivo que recebe a tabela de resultados
+ *  \return nmero de conjuntos avaliados
+ *  \sa lote_executa(), gerador_conjunto()
+ *
+ * Cada thread gera o conjunto na sua arena e o avalia em seguida. A tabela  a mesma que
+ * lote_executa() escreve para o arquivo de gerador_escreve() com as mesmas opes.
+ */
+long lote_executa_gerador(const gerador_opcoes_t *gerador, const lote_opcoes_t *opcoes, FILE *fp);
+
+#endif // LOTE_H_INCLUDED
@@ -18,44 +18,282 @@
 #include "tarefas.h"
 #include "lista_enc.h"
 #include "no.h"
+#include "arena.h"
+#include "tabela.h"
+#include "escalonador.h"
+#include "analise.h"
+#include "leitor.h"
+#include "politica.h"
+#include "saida.h"
+#include "escritor.h"
+#include "traco.h"
+#include "renderiza.h"
+#include "paginador.h"
+#include "particao.h"
+#include "lote.h"
+#include "gerador.h"
+
+
+//#define DEBUG
+
+// Escalonamento particionado: cada ncleo  simulado em sua thread, e o diagrama tem uma linha de CPU por ncleo
+static int simula_particionado(particao_t* particao, lista_enc_t* listaTarefas, const politica_t* politica,
+                               uint64_t horizonte, uint64_t ciclo, uint64_t janelaInicio, uint64_t janelaFim, uint64_t ticksPagina,
+                               int falhaRapida, int numTarefa, const char* svalue)
+{
+    int nucleos = particao_nucleos(particao);
+    tabela_t** tabelas;
+    uint64_t* fins;
+    uint32_t* ids;
+    no_t* no;
+    saida_t* saidaGannt;
+    paginador_t* paginadorGannt;
+    escritor_t* escritorGannt;
+    FILE* fp_estatisticas = stdout;
+    int k, i;
+
+    tabelas = malloc((size_t) nucleos*sizeof(tabela_t*));
+    fins = malloc((size_t) nucleos*sizeof(uint64_t));
+    ids = malloc(((size_t) numTarefa + 1)*sizeof(uint32_t));
+    if(tabelas == NULL || fins == NULL || ids == NULL){
+        perror("simula_particionado:");
+        exit(EXIT_FAILURE);
+    }
+
+    saidaGannt = cria_saida("diagramaGannt.tex");
+    if(saidaGannt == NULL){
+        printf("Erro na abertura do arquivo BINARIO!\n");
+        return -1;
+    }else
+        printf("Arquivo .tex aberto com sucesso.\n");
+
+    ordena_tarefas(listaTarefas);                       // Linhas do diagrama na ordem de prioridade global
+    for(i = 0, no = obter_cabeca(listaTarefas); no && i < numTarefa; no = obtem_proximo(no)){
+        ids[i++] = tarefa_get_id((tarefa_t*) obter_dado(no));
+    }
+
+    for(k = 0; k < nucleos; k++){
+        ordena_tarefas(particao_lista(particao, k));
+        tabelas[k] = cria_tabela(particao_lista(particao, k));
+    }
+
+    paginadorGannt = cria_paginador(saidaGannt, i, nucleos, ids, horizonte, janelaInicio, janelaFim, ticksPagina);
+    escritorGannt = cria_escritor_nucleos(paginadorGannt, NULL, nucleos);
+    escalonador_simula_nucleos(tabelas, nucleos, politica, horizonte, ciclo, falhaRapida, numTarefa,
+                               escritorGannt, fins);
+    finaliza_escritor(escritorGannt);
+
+    if(svalue){
+        fp_estatisticas = fopen(svalue, "w");
+        if(fp_estatisticas == NULL){
+            perror(svalue);
+        }
+    }
+    for(k = 0; k < nucleos; k++){
+        printf("\nNucleo %d (U = %.4f):\n", k + 1, particao_utilizacao(particao, k));
+        if(tabela_imprime_perdas(stdout, tabelas[k]) && falhaRapida){
+            printf("Simulacao interrompida na primeira perda de prazo, em t = %" PRIu64 "\n", fins[k]);
+        }else if(fins[k] < horizonte){
+            printf("Escalonamento se repete a cada %" PRIu64 " a partir de t = %" PRIu64 ", simulacao encerrada em t = %" PRIu64 "\n",
+                   ciclo, fins[k] - ciclo, fins[k]);
+        }
+        if(fp_estatisticas == stdout){
+            printf("\n");
+            tabela_imprime_estatisticas(stdout, tabelas[k]);
+        }else if(fp_estatisticas){                      // No arquivo cada tabela  precedida pelo seu ncleo
+            fprintf(fp_estatisticas, "Nucleo %d\n", k + 1);
+            tabela_imprime_estatisticas(fp_estatisticas, tabelas[k]);
+        }
+        desaloca_tabela(tabelas[k]);
+    }
+    if(fp_estatisticas && fp_estatisticas != stdout){
+        fclose(fp_estatisticas);
+    }
+
+    finaliza_paginador(paginadorGannt);
 
+    free(tabelas);
+    free(fins);
+    free(ids);
 
-#define BUFFER_SIZE 10
-#define DEBUG
-#define HUGE_VALUE  100000
+    if(fecha_saida(saidaGannt) < 0){
+        printf("\nERRO ao FECHAR o arquivo .tex!\n");
+        return -1;
+    }
+    printf("\nArquivo .tex FECHADO com sucesso!\n");
+
+    return 0;
+}
 
 int main (int argc, char **argv)
 {
-    tarefa_t* tarefaAtual;
-    tarefa_t* tarefaPrio;
     lista_enc_t* listaTarefas;
+    arena_t* arenaTarefas;
+    tabela_t* tabelaTarefas;
+    #ifdef DEBUG
+    tarefa_t* tarefaAtual;
     no_t* no_aux;
-    unsigned long int ticks, tempo_cpu;
-    int hiper_periodo;
+    #endif
+    uint64_t hiper_periodo;
+    uint64_t horizonte, maior_fase, fim_simulacao;
+    uint64_t limite = 0;
+    uint64_t janelaInicio = 0, janelaFim = UINT64_MAX;
+    uint64_t ticksPagina = 0;
+    uint64_t preempcoes, migracoes;
+    VEREDITO veredito;
+    double utilizacao;
+    char vereditos[3][20] = { {"ESCALONAVEL"},
+                              {"NAO ESCALONAVEL"},
+                              {"INCONCLUSIVO"}
+                            };
+    int analisar = 0;
+    int falhaRapida = 0;
+    int interrompida;
+    const politica_t* politica = &politica_rm;
+    int nucleos = 1;
+    int global = 0;
+    HEURISTICA heuristica = PRIMEIRO_AJUSTE;
+    ADMISSAO admissao = ADMISSAO_RTA;
+    particao_t* particao = NULL;
+    int rejeitadas;
+    lote_opcoes_t opcoesLote;
+    gerador_opcoes_t opcoesGerador;
+    int gerar = 0;
+    int emMemoria = 0;
 
     char *cvalue = NULL;
-    int indice, auxC, auxT;
+    char *svalue = NULL;
+    char *tvalue = NULL;
+    char *rvalue = NULL;
+    char *dvalue = NULL;
+    int trabalhadores = 0;
+    int formatoCsv = 0;
+    FILE *fp_estatisticas;
+    char *fim;
+    int indice;
     int c, i;
 
-    FILE *fp = NULL;
-    FILE *fp_diagramaGannt = NULL;
-    char close;
+    saida_t *saidaGannt = NULL;
+    paginador_t *paginadorGannt;
+    escritor_t *escritorGannt;
+    gravador_t *gravadorTraco = NULL;
+    traco_t *traco;
+    int close;
 
-    char str[BUFFER_SIZE], strAux[BUFFER_SIZE];
-    int numTarefa = HUGE_VALUE;
+    int numTarefa = 0;
 
     opterr = 0;
 
-    listaTarefas = cria_lista_enc();
+    arenaTarefas = cria_arena(ARENA_BLOCO_PADRAO);     // Lista, ns e tarefas do conjunto ficam na mesma arena
+    listaTarefas = cria_lista_enc_arena(arenaTarefas);
 
-    while ((c = getopt(argc, argv, "c:")) != -1)
+    while ((c = getopt(argc, argv, "c:p:l:s:t:r:o:j:k:m:b:e:d:w:G:afgB")) != -1)
 
     switch (c){
         case 'c':
             cvalue = optarg;
             break;
+        case 'p':
+            politica = politica_busca(optarg);
+            if (politica == NULL){
+                fprintf (stderr, "Politica desconhecida `%s', use rm ou edf.\n", optarg);
+                return 1;
+            }
+            break;
+        case 'a':
+            analisar = 1;
+            break;
+        case 's':
+            svalue = optarg;
+            break;
+        case 'f':
+            falhaRapida = 1;
+            break;
+        case 't':
+            tvalue = optarg;
+            break;
+        case 'r':
+            rvalue = optarg;
+            break;
+        case 'o':
+            if (strcmp(optarg, "csv") == 0){
+                formatoCsv = 1;
+            }else if (strcmp(optarg, "tex") == 0){
+                formatoCsv = 0;
+            }else{
+                fprintf (stderr, "Formato desconhecido `%s', use tex ou csv.\n", optarg);
+                return 1;
+            }
+            break;
+        case 'l':
+            limite = strtoull(optarg, &fim, 10);
+            if (*fim != '\0' || limite == 0){
+                fprintf (stderr, "Limite de simulacao invalido `%s'.\n", optarg);
+                return 1;
+            }
+            break;
+        case 'j':
+            janelaInicio = strtoull(optarg, &fim, 10);
+            if (*fim == ':'){
+                janelaFim = strtoull(fim + 1, &fim, 10);
+            }
+            if (*fim != '\0' || janelaFim <= janelaInicio){
+                fprintf (stderr, "Janela invalida `%s', use -j inicio:fim.\n", optarg);
+                return 1;
+            }
+            break;
+        case 'k':
+            ticksPagina = strtoull(optarg, &fim, 10);
+            if (*fim != '\0' || ticksPagina == 0){
+                fprintf (stderr, "Tamanho de pagina invalido `%s'.\n", optarg);
+                return 1;
+            }
+            break;
+        case 'm':
+            nucleos = (int) strtol(optarg, &fim, 10);
+            if (*fim != '\0' || nucleos < 1){
+                fprintf (stderr, "Numero de nucleos invalido `%s'.\n", optarg);
+                return 1;
+            }
+            break;
+        case 'g':
+            global = 1;
+            break;
+        case 'd':
+            dvalue = optarg;
+            break;
+        case 'w':
+            trabalhadores = (int) strtol(optarg, &fim, 10);
+            if (*fim != '\0' || trabalhadores < 1){
+                fprintf (stderr, "Numero de threads invalido `%s'.\n", optarg);
+                return 1;
+            }
+            break;
+        case 'G':
+            if (gerador_le_opcoes(optarg, &opcoesGerador) < 0){
+                return 1;
+            }
+            gerar = 1;
+            break;
+        case 'B':
+            emMemoria = 1;
+            break;
+        case 'b':
+            if (particao_heuristica(optarg, &heuristica) < 0){
+                fprintf (stderr, "Heuristica desconhecida `%s', use ff, bf ou wf.\n", optarg);
+                return 1;
+            }
+            break;
+        case 'e':
+            if (particao_admissao(optarg, &admissao) < 0){
+                fprintf (stderr, "Teste de admissao desconhecido `%s', use rta ou util.\n", optarg);
+                return 1;
+            }
+            break;
         case '?':
-            if (optopt == 'c')
+            if (optopt == 'c' || optopt == 'p' || optopt == 'l' || optopt == 's' || optopt == 't' || optopt == 'r'
+                || optopt == 'o' || optopt == 'j' || optopt == 'k' || optopt == 'm' || optopt == 'b' || optopt == 'e'
+                || optopt == 'd' || optopt == 'w' || optopt == 'G')
                 fprintf (stderr, "Opcao -%c requer um argumento.\n", optopt);
             else if (isprint (optopt))
                 fprintf (stderr, "Opcao desconhecida `-%c'.\n", optopt);
@@ -66,139 +304,272 @@ int main (int argc, char **argv)
             abort();
     }
 
-    fp = fopen(cvalue, "r");
+    if(rvalue){                                         // Gera a sada a partir de um trao, sem simular
+        traco = abre_traco(rvalue);
+        if(traco == NULL){
+            return -1;
+        }
+        printf("Traco com %" PRIu32 " tarefas e %zu eventos, simulado ate t = %" PRIu64 "\n",
+               traco_cabecalho(traco)->numTarefas, traco_num_eventos(traco), traco_fim(traco));
+
+        saidaGannt = cria_saida(formatoCsv ? "diagramaGannt.csv" : "diagramaGannt.tex");
+        if(saidaGannt == NULL){
+            printf("Erro na abertura do arquivo de saida!\n");
+            fecha_traco(traco);
+            return -1;
+        }
+        if(formatoCsv){
+            renderiza_csv(traco, saidaGannt, janelaInicio, janelaFim);
+        }else{
+            renderiza_latex(traco, saidaGannt, janelaInicio, janelaFim, ticksPagina);
+        }
+        fecha_traco(traco);
 
-    if(fp == NULL){                                     // Verificao de erro na abertura
-        printf("ERRO na leitura do arquivo de entrada!\n");
-        return -1;
-    }else
-        printf("Arquivo de entrada ABERTO com sucesso.\n\n");
-
-    i = numTarefa;
-
-    while(!feof(fp) && i > 0){                                   // Sair do lao caso alcance o final do arquivo
-        fgets(str, BUFFER_SIZE, fp);                    // L uma linha do arquivo at '\n', retorna NULL em str caso falhe
-
-        if(str != NULL){                              // Caso no tenha falhado a leitura da linha
-            // Leitura do cabealho
-            memset (strAux, '-', BUFFER_SIZE - 1);      // Limpa a string auxiliar - resolve problemas com '\n'
-            sscanf(str, "%s", strAux);                  // Armazena a primeira string de str em strAux.
-            if(!strncmp(strAux, "N", 1)){
-                sscanf(str, "N;%d", &numTarefa);
-                i = numTarefa;
-                #ifdef DEBUG
-                printf("Numero de Tarefas = %d\n", numTarefa);
-                #endif
-            }else if(!strcmp(strAux, "id;C;T")){
-                #ifdef DEBUG
-                printf("Cabecalho adquirido com SUCESSO\n\n");
-                #endif
-            }else{
-                sscanf(str, "T%d;%d;%d", &indice, &auxC, &auxT);
-                tarefaAtual = cria_tarefa(indice, auxC, auxT);
-                no_aux = cria_no((void*) tarefaAtual);
-                add_cauda(listaTarefas, no_aux);
-                i--;
-                printf("Armazenado \tT%d\tC: %d\tT: %d\n", indice, auxC, auxT);
+        if(fecha_saida(saidaGannt) < 0){
+            printf("ERRO ao FECHAR o arquivo de saida!\n");
+            return -1;
+        }
+        printf("Arquivo %s gerado a partir do traco.\n", formatoCsv ? "diagramaGannt.csv" : "diagramaGannt.tex");
+        desaloca_arena(arenaTarefas);
+        return 0;
+    }
+
+    if(emMemoria && !gerar){
+        fprintf (stderr, "Opcao -B requer -G <opcoes do gerador>.\n");
+        return 1;
+    }
+
+    if(dvalue || gerar){                                // Lote: diretrio, arquivo de vrios conjuntos ou gerador, sem Diagrama de Gannt
+        opcoesLote.politica = politica;
+        opcoesLote.nucleos = nucleos;
+        opcoesLote.global = global;
+        opcoesLote.heuristica = heuristica;
+        opcoesLote.admissao = admissao;
+        opcoesLote.analisar = analisar;
+        opcoesLote.falhaRapida = falhaRapida;
+        opcoesLote.limite = limite;
+        opcoesLote.trabalhadores = trabalhadores;
+
+        fp_estatisticas = stdout;                       // Com -s a tabela ou os conjuntos gerados vo para o arquivo
+        if(svalue){
+            fp_estatisticas = fopen(svalue, "w");
+            if(fp_estatisticas == NULL){
+                perror(svalue);
+                return -1;
             }
         }
+        if(gerar && !emMemoria){                        // S escreve os conjuntos, no formato de entrada
+            i = gerador_escreve(fp_estatisticas, &opcoesGerador);
+        }else if(gerar){                                // Gera e avalia cada conjunto direto na memria
+            lote_executa_gerador(&opcoesGerador, &opcoesLote, fp_estatisticas);
+            i = 0;
+        }else{
+            i = lote_executa(dvalue, &opcoesLote, fp_estatisticas);
+        }
+        if(fp_estatisticas != stdout){
+            fclose(fp_estatisticas);
+        }
+        desaloca_arena(arenaTarefas);
+        return i < 0 ? -1 : 0;
     }
 
-    close = fclose(fp);                                              // Fechando o arquivo de entrada aberto
-    if(close == EOF){                                                // Verificando erro no fechamento do arquivo de entrada
-        printf("\nERRO ao FECHAR o arquivo de entrada!\n");
+    if(cvalue == NULL){
+        printf("ERRO: arquivo de entrada nao informado, use -c <arquivo>\n");
         return -1;
-    }else{
-        printf("\nArquivo de entrada FECHADO com sucesso!\n\n");
     }
 
+    if(leitor_carrega(cvalue, arenaTarefas, listaTarefas, &numTarefa) < 0){    // L todo o arquivo de uma vez
+        printf("ERRO na leitura do arquivo de entrada!\n");
+        return -1;
+    }else
+        printf("Arquivo de entrada LIDO com sucesso.\n\n");
+
+    #ifdef DEBUG
+    printf("Numero de Tarefas = %d\n", numTarefa);
+    for(no_aux = obter_cabeca(listaTarefas); no_aux; no_aux = obtem_proximo(no_aux)){
+        tarefaAtual = (tarefa_t*) obter_dado(no_aux);
+        printf("Armazenado \tT%" PRIu32 "\tC: %" PRIu64 "\tT: %" PRIu64 "\n", tarefa_get_id(tarefaAtual),
+               tarefa_get_duracao(tarefaAtual), tarefa_get_periodo(tarefaAtual));
+    }
+    puts("");
+    #endif
+
     printf ("cvalue = %s\n", cvalue);
 
     for (indice = optind; indice < argc; indice++)
         printf ("Non-option argument %s\n", argv[indice]);
 
-    fp_diagramaGannt = fopen("diagramaGannt.tex", "w");        // Abrindo arquivo para escrita em .tex
-    if(fp_diagramaGannt == NULL){                              // Verificao de erro na abertura do arquivo
+    if(politica == &politica_edf){                      // Teste O(n) logo aps a leitura
+        veredito = analise_utilizacao_edf(listaTarefas, &utilizacao);
+    }else{
+        veredito = analise_utilizacao(listaTarefas, &utilizacao);
+    }
+    if(nucleos > 1 && global){                          // Global: teste de densidade em m ncleos
+        veredito = analise_global(listaTarefas, nucleos, politica, &utilizacao);
+        printf("Utilizacao = %.4f em %d nucleos - teste global: %s\n", utilizacao, nucleos, vereditos[veredito]);
+        if(analisar){
+            printf("Conjunto %s\n", vereditos[veredito]);
+            desaloca_arena(arenaTarefas);
+            return 0;
+        }
+    }else if(nucleos > 1){                              // Particionado: o teste  o de admisso em cada ncleo
+        printf("Utilizacao = %.4f em %d nucleos\n", utilizacao, nucleos);
+        particao = cria_particao(arenaTarefas, listaTarefas, nucleos, heuristica, admissao, politica);
+        particao_imprime(stdout, particao);
+
+        rejeitadas = tamanho_lista(particao_rejeitadas(particao));
+        if(analisar || rejeitadas){
+            // A heurstica pode falhar com um conjunto escalonvel: s U > m garante que no 
+            if(rejeitadas == 0){
+                veredito = ESCALONAVEL;
+            }else if(utilizacao > nucleos + ANALISE_TOLERANCIA){
+                veredito = NAO_ESCALONAVEL;
+            }else{
+                veredito = INCONCLUSIVO;
+            }
+            printf("Conjunto %s\n", vereditos[veredito]);
+            if(rejeitadas && !analisar){
+                printf("%d tarefas sem nucleo, simulacao cancelada.\n", rejeitadas);
+            }
+            desaloca_arena(arenaTarefas);
+            return analisar ? 0 : -1;
+        }
+    }else{
+        printf("Utilizacao = %.4f - teste de utilizacao: %s\n", utilizacao, vereditos[veredito]);
+    }
+
+    if(analisar && veredito != INCONCLUSIVO){           // O teste de utilizao j decidiu
+        printf("Conjunto %s\n", vereditos[veredito]);
+        desaloca_arena(arenaTarefas);
+        return 0;
+    }
+
+    if(analisar){                                       // Modo de anlise: QPA ou RTA, sem simulao nem Diagrama de Gannt
+        veredito = analise_exata(listaTarefas, politica, stdout);
+        printf("Conjunto %s\n", vereditos[veredito]);
+        desaloca_arena(arenaTarefas);
+        return 0;
+    }
+
+    hiper_periodo = tarefas_calcMMC(listaTarefas);
+    horizonte = hiper_periodo;
+    if(hiper_periodo == MMC_ESTOURO){
+        printf("HiperPeriodo nao cabe em 64 bits!\n");
+    }else{
+        printf("HiperPeriodo = %" PRIu64 "\n", hiper_periodo);
+        maior_fase = tarefas_maior_fase(listaTarefas);
+        if(maior_fase){                                         // Com fases o intervalo  [0, maior fase + 2H]
+            if(hiper_periodo > (UINT64_MAX - maior_fase)/2){
+                horizonte = MMC_ESTOURO;
+                printf("Intervalo de simulacao nao cabe em 64 bits!\n");
+            }else{
+                horizonte = maior_fase + 2*hiper_periodo;
+                printf("Intervalo de simulacao = %" PRIu64 "\n", horizonte);
+            }
+        }
+    }
+    if(horizonte == MMC_ESTOURO && !limite){
+        printf("Use -l para simular uma janela limitada.\n");
+        desaloca_arena(arenaTarefas);
+        return -1;
+    }
+    if(limite && (horizonte == MMC_ESTOURO || horizonte > limite)){
+        horizonte = limite;                                     // Simula somente a janela [0, limite]
+        printf("Simulacao limitada a %" PRIu64 "\n", horizonte);
+    }
+    if(janelaInicio >= horizonte){
+        printf("Janela do diagrama fora do intervalo simulado [0, %" PRIu64 "]\n", horizonte);
+        desaloca_arena(arenaTarefas);
+        return -1;
+    }
+
+    if(nucleos > 1 && tvalue){
+        printf("Traco binario nao suportado com mais de um nucleo, -t ignorado.\n");
+        tvalue = NULL;
+    }
+    if(particao){
+        i = simula_particionado(particao, listaTarefas, politica, horizonte, hiper_periodo, janelaInicio, janelaFim,
+                                ticksPagina, falhaRapida, numTarefa, svalue);
+        desaloca_arena(arenaTarefas);
+        return i;
+    }
+
+    saidaGannt = cria_saida("diagramaGannt.tex");              // Abrindo arquivo para escrita em .tex
+    if(saidaGannt == NULL){                                    // Verificao de erro na abertura do arquivo
         printf("Erro na abertura do arquivo BINARIO!\n");
         return -1;
     }else
         printf("Arquivo .tex aberto com sucesso.\n");
 
-    hiper_periodo = tarefas_calcMMC(listaTarefas);
-    printf("HiperPeriodo = %d\n", hiper_periodo);
-
     ordena_tarefas(listaTarefas);
 
-    gannt_cabecalho(fp_diagramaGannt, numTarefa, hiper_periodo);
+    tabelaTarefas = cria_tabela(listaTarefas);         // Simulao  feita sobre a tabela, na ordem de prioridade
 
-    gannt_nomenclatura(fp_diagramaGannt, listaTarefas);
+    // Somente a janela pedida  desenhada, em pginas de ticksPagina (0: uma s pgina)
+    paginadorGannt = cria_paginador(saidaGannt, numTarefa, nucleos, tabelaTarefas->id, horizonte, janelaInicio, janelaFim,
+                                    ticksPagina);
 
-    ticks = 0;
-    tempo_cpu = 0;
-    tarefaAtual = NULL;
-
-    while(ticks<=hiper_periodo){
-        update_tarefas(listaTarefas, ticks, fp_diagramaGannt);
-        tarefaPrio = retorna_tarefa_prio(listaTarefas);
-        if(tarefaPrio){
-            if(tempo_cpu==HUGE_VALUE){
-                tempo_cpu = ticks;
-            }
-            if(tarefaAtual != tarefaPrio){
-                if(tarefaAtual){
-                    if(tarefa_checa_termino(tarefaAtual, ticks)){
-                        gannt_quadrado(fp_diagramaGannt, tarefa_get_id(tarefaAtual),tarefa_get_inicio(tarefaAtual),ticks);
-                        gannt_seta_baixo(fp_diagramaGannt, tarefa_get_id(tarefaAtual), ticks);
-                    }else{
-                        gannt_quadrado(fp_diagramaGannt, tarefa_get_id(tarefaAtual),tarefa_get_inicio(tarefaAtual),ticks);
-                        tarefa_set_pausa(tarefaAtual, ticks);
-                    }
-                }
-                tarefaAtual = tarefaPrio;
-                tarefa_set_inicio(tarefaAtual, ticks);
-            }
-
-            if(tarefa_checa_termino(tarefaAtual, ticks)){
-                gannt_quadrado(fp_diagramaGannt,tarefa_get_id(tarefaAtual),tarefa_get_inicio(tarefaAtual),ticks);
-                gannt_seta_baixo(fp_diagramaGannt, tarefa_get_id(tarefaAtual), ticks);
-                tarefaAtual = retorna_tarefa_prio(listaTarefas);
-                if(tarefaAtual){
-                    tarefa_set_inicio(tarefaAtual, ticks);
-                }else{
-                    gannt_quadrado(fp_diagramaGannt,numTarefa+1,tempo_cpu,ticks);
-                    tempo_cpu=HUGE_VALUE;
-                }
-            }
-        }else if(tempo_cpu!=HUGE_VALUE){
-            printf("Entrou aqui\n");
-            gannt_quadrado(fp_diagramaGannt,numTarefa+1,tempo_cpu,ticks-1);
-            tempo_cpu=HUGE_VALUE;
+    if(tvalue){                                         // Trao binrio gravado junto com o .tex
+        gravadorTraco = cria_gravador(tvalue, tabelaTarefas, horizonte);
+        if(gravadorTraco == NULL){
+            perror(tvalue);
         }
+    }
 
-
-        #ifdef DEBUG
-            printf("Tick: %d\n", (int) ticks);
-            imprime_tarefas(listaTarefas);
-            puts("");
-        #endif // DEBUG
-
-        ticks++;
+    escritorGannt = cria_escritor(paginadorGannt, gravadorTraco, 1);   // Formatao do .tex em outra thread, junto com a simulao
+    if(nucleos > 1){                                    // Global: uma linha de CPU por ncleo
+        fim_simulacao = escalonador_simula_global(tabelaTarefas, politica, horizonte, hiper_periodo, falhaRapida,
+                                                  numTarefa, nucleos, escritorGannt);
+    }else{
+        fim_simulacao = escalonador_simula(tabelaTarefas, politica, horizonte, hiper_periodo, falhaRapida, numTarefa,
+                                           escritorGannt);
+    }
+    finaliza_escritor(escritorGannt);
+    interrompida = tabela_imprime_perdas(stdout, tabelaTarefas) && falhaRapida;
+    // Depois de uma repetio os eventos continuam at o horizonte; s a perda com -f os encerra antes
+    if(gravadorTraco && fecha_gravador(gravadorTraco, interrompida ? fim_simulacao : horizonte) < 0){
+        printf("ERRO ao gravar o traco %s!\n", tvalue);
+    }
+    if(interrompida){
+        printf("Simulacao interrompida na primeira perda de prazo, em t = %" PRIu64 "\n", fim_simulacao);
+    }else if(fim_simulacao < horizonte){
+        printf("Escalonamento se repete a cada %" PRIu64 " a partir de t = %" PRIu64 ", simulacao encerrada em t = %" PRIu64 "\n",
+               hiper_periodo, fim_simulacao - hiper_periodo, fim_simulacao);
+    }
+    if(nucleos > 1){
+        preempcoes = migracoes = 0;
+        for(i = 0; i < tabelaTarefas->n; i++){
+            preempcoes += tabelaTarefas->preempcoes[i];
+            migracoes += tabelaTarefas->migracoes[i];
+        }
+        printf("Preempcoes = %" PRIu64 ", migracoes = %" PRIu64 "\n", preempcoes, migracoes);
     }
-    if(tempo_cpu!=HUGE_VALUE && tempo_cpu!=(ticks-1)){  // && ticks!=tempo_cpu desnecessrio
-        gannt_quadrado(fp_diagramaGannt,numTarefa+1,tempo_cpu,ticks-1);
+
+    if(svalue){                                         // Resumo das estatsticas em arquivo prprio
+        fp_estatisticas = fopen(svalue, "w");
+        if(fp_estatisticas == NULL){
+            perror(svalue);
+        }else{
+            tabela_imprime_estatisticas(fp_estatisticas, tabelaTarefas);
+            fclose(fp_estatisticas);
+        }
+    }else{
+        printf("\n");
+        tabela_imprime_estatisticas(stdout, tabelaTarefas);
     }
 
-    gannt_finaliza_cabecalho(fp_diagramaGannt);
+    finaliza_paginador(paginadorGannt);
 
-    close = fclose(fp_diagramaGannt);                       // Fechando o arquivo aberto
-    if(close == EOF){                                       // Verificando erro no fechamento do arquivo
+    close = fecha_saida(saidaGannt);                        // Descarrega o buffer e fecha o arquivo
+    if(close < 0){                                          // Verificando erro no fechamento do arquivo
         printf("\nERRO ao FECHAR o arquivo .tex!\n");
         return -1;
     }else{
         printf("\nArquivo .tex FECHADO com sucesso!\n");
     }
 
-    desaloca_lista_tarefas(listaTarefas); // Desaloca lista, ns da lista e tarefas dos ns
+    desaloca_tabela(tabelaTarefas);
+    desaloca_arena(arenaTarefas);         // Desaloca lista, ns da lista e tarefas dos ns de uma s vez
 
     return 0;
 }
@@ -35,6 +35,17 @@ no_t *cria_no(void *dado)
     return p;
 }
 
+no_t *cria_no_arena(arena_t *arena, void *dado)
+{
+    no_t *p = arena_aloca(arena, sizeof(no_t));
+
+    p->dados = dado;
+    p->proximo = NULL;
+    p->anterior = NULL;
+
+    return p;
+}
+
 void liga_nos (no_t *fonte, no_t *destino)
 {
     if (fonte == NULL || destino == NULL){
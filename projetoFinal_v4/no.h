@@ -10,9 +10,13 @@
 #ifndef NO_H_INCLUDED
 #define NO_H_INCLUDED
 
+#include "arena.h"
+
 typedef struct nos no_t;
 
 no_t *cria_no(void *dado);
+/* N alocado na arena: no deve ser liberado com free() */
+no_t *cria_no_arena(arena_t *arena, void *dado);
 
 void liga_nos (no_t *fonte, no_t *destino);
 void desliga_no (no_t *no);
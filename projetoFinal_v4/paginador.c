@@ -0,0 +1,244 @@
+/** \file paginador.c
+ * \brief   Paginao do Diagrama de Gannt (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "paginador.h"
+#include "tarefas.h"
+
+struct paginadores {
+    saida_t *saida;
+    uint32_t numTarefas;
+    uint32_t nucleos;           // Linhas de CPU depois das tarefas
+    uint32_t *ids;
+    uint64_t inicio;            // Janela desenhada, fim j limitado ao horizonte
+    uint64_t fim;
+    uint64_t ticks;             // Ticks por pgina, 0 para uma s pgina
+    uint64_t numPaginas;
+    uint64_t proxima;           // Prxima pgina a abrir; a pgina aberta  a anterior
+    int recorte;                // Janela ou pginas: o diagrama no  o intervalo inteiro de uma vez
+};
+
+paginador_t *cria_paginador(saida_t *saida, uint32_t numTarefas, uint32_t nucleos, const uint32_t *ids,
+                            uint64_t horizonte, uint64_t inicio, uint64_t fim, uint64_t ticks)
+{
+    paginador_t *p;
+
+    if (saida == NULL || (ids == NULL && numTarefas) || nucleos == 0){
+        fprintf(stderr,"cria_paginador: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    p = malloc(sizeof(paginador_t));
+    if (p == NULL){
+        perror("cria_paginador:");
+        exit(EXIT_FAILURE);
+    }
+
+    p->ids = malloc(((size_t) numTarefas + 1)*sizeof(uint32_t));
+    if (p->ids == NULL){
+        perror("cria_paginador:");
+        exit(EXIT_FAILURE);
+    }
+    if (numTarefas)
+        memcpy(p->ids, ids, numTarefas*sizeof(uint32_t));
+
+    if (fim > horizonte)
+        fim = horizonte;
+    if (inicio > fim)
+        inicio = fim;
+    if (ticks >= fim - inicio)          // A janela cabe em uma pgina
+        ticks = 0;
+
+    p->saida = saida;
+    p->numTarefas = numTarefas;
+    p->nucleos = nucleos;
+    p->inicio = inicio;
+    p->fim = fim;
+    p->ticks = ticks;
+    p->numPaginas = ticks ? (fim - inicio)/ticks + ((fim - inicio)%ticks != 0) : 1;
+    p->proxima = 0;
+    p->recorte = inicio != 0 || fim != horizonte || ticks != 0;
+
+    gannt_documento(saida);
+
+    return p;
+}
+
+static uint64_t inicio_pagina(paginador_t *p, uint64_t k)
+{
+    return p->inicio + k*p->ticks;
+}
+
+static uint64_t fim_pagina(paginador_t *p, uint64_t k)
+{
+    return k + 1 < p->numPaginas ? p->inicio + (k + 1)*p->ticks : p->fim;
+}
+
+// Pgina do instante: cada limite pertence  pgina que comea nele, o fim da janela  ltima
+static uint64_t pagina_de(paginador_t *p, uint64_t tempo)
+{
+    uint64_t k;
+
+    if (!p->ticks)
+        return 0;
+
+    k = (tempo - p->inicio)/p->ticks;
+
+    return k < p->numPaginas ? k : p->numPaginas - 1;
+}
+
+static void fecha_pagina(paginador_t *p, uint64_t k)
+{
+    gannt_finaliza_grade(p->saida);
+    gannt_legenda(p->saida, inicio_pagina(p, k), fim_pagina(p, k), k + 1);
+}
+
+// Fecha a pgina aberta e abre as seguintes at k, mesmo que fiquem vazias
+static void abre_ate(paginador_t *p, uint64_t k)
+{
+    uint64_t inicio, fim;
+    uint32_t largura, j;
+
+    while (p->proxima <= k){
+        if (p->proxima){
+            fecha_pagina(p, p->proxima - 1);
+            saida_cadeia(p->saida, "\\clearpage\n\n");
+        }
+
+        inicio = inicio_pagina(p, p->proxima);
+        fim = fim_pagina(p, p->proxima);
+
+        // A ltima pgina pode ser mais curta: a largura acompanha para manter a escala
+        largura = GANNT_LARGURA;
+        if (p->ticks){
+            largura = (uint32_t) ((double) GANNT_LARGURA*(fim - inicio)/p->ticks + 0.5);
+            if (largura == 0)
+                largura = 1;
+        }
+
+        gannt_grade(p->saida, p->numTarefas + p->nucleos, inicio, fim, largura);
+        gannt_rotulo_cpu(p->saida, p->numTarefas, p->nucleos);
+        for (j = 0; j < p->numTarefas; j++)
+            gannt_rotulo_tarefa(p->saida, p->ids[j]);
+        saida_caractere(p->saida, '\n');
+
+        p->proxima++;
+    }
+}
+
+void finaliza_paginador(paginador_t *paginador)
+{
+    if (paginador == NULL){
+        fprintf(stderr,"finaliza_paginador: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    abre_ate(paginador, paginador->numPaginas - 1);
+
+    if (paginador->recorte){
+        fecha_pagina(paginador, paginador->numPaginas - 1);
+        gannt_finaliza_documento(paginador->saida);
+    }else{
+        gannt_finaliza_cabecalho(paginador->saida);
+    }
+
+    free(paginador->ids);
+    free(paginador);
+}
+
+int paginador_evento(paginador_t *paginador, const evento_t *evento)
+{
+    paginador_t *p = paginador;
+    uint64_t a, b, k, inicio;
+
+    if (p == NULL || evento == NULL){
+        fprintf(stderr,"paginador_evento: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    if (evento->tipo == EVENTO_EXECUCAO){
+        a = evento->inicio > p->inicio ? evento->inicio : p->inicio;
+        b = evento->fim < p->fim ? evento->fim : p->fim;
+        if (a > b)
+            return 0;
+
+        k = pagina_de(p, a);
+        if (p->proxima && k < p->proxima - 1){     // Comeou em uma pgina j fechada
+            k = p->proxima - 1;
+            if (a < inicio_pagina(p, k))
+                a = inicio_pagina(p, k);
+        }
+        if (b > fim_pagina(p, k))
+            b = fim_pagina(p, k);
+        if (a > b || (a == b && p->recorte))
+            return 0;
+
+        abre_ate(p, k);
+        inicio = inicio_pagina(p, k);
+        gannt_quadrado(p->saida, evento->id, a - inicio, b - inicio);
+        return 1;
+    }
+
+    if (evento->tipo != EVENTO_CHEGADA && evento->tipo != EVENTO_TERMINO)
+        return 0;
+    if (evento->inicio < p->inicio || evento->inicio > p->fim)
+        return 0;
+
+    k = pagina_de(p, evento->inicio);
+    if (p->proxima && k < p->proxima - 1)
+        return 0;
+
+    abre_ate(p, k);
+    inicio = inicio_pagina(p, k);
+    if (evento->tipo == EVENTO_CHEGADA)
+        gannt_seta_cima(p->saida, evento->id, evento->inicio - inicio);
+    else
+        gannt_seta_baixo(p->saida, evento->id, evento->inicio - inicio);
+
+    return 1;
+}
+
+int paginador_visivel(const paginador_t *paginador, const evento_t *evento)
+{
+    switch (evento->tipo){
+        case EVENTO_EXECUCAO:
+            return evento->fim >= paginador->inicio && evento->inicio <= paginador->fim;
+        case EVENTO_CHEGADA:
+        case EVENTO_TERMINO:
+            return evento->inicio >= paginador->inicio && evento->inicio <= paginador->fim;
+        default:
+            return 0;
+    }
+}
+
+uint64_t paginador_quebra(const paginador_t *paginador, uint64_t tempo)
+{
+    uint64_t k;
+
+    if (!paginador->ticks)
+        return UINT64_MAX;
+
+    k = tempo < paginador->inicio ? 1 : (tempo - paginador->inicio)/paginador->ticks + 1;
+
+    return k < paginador->numPaginas ? paginador->inicio + k*paginador->ticks : UINT64_MAX;
+}
+
+uint64_t paginador_inicio(const paginador_t *paginador)
+{
+    return paginador->inicio;
+}
+
+uint64_t paginador_fim(const paginador_t *paginador)
+{
+    return paginador->fim;
+}
@@ -0,0 +1,54 @@
+/** \file paginador.h
+ * \brief   Cabealho da paginao do Diagrama de Gannt (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ * O diagrama pode mostrar somente uma janela [inicio, fim] do intervalo simulado e dividir essa
+ * janela em pginas de um nmero fixo de ticks, cada uma com seu prprio RTGrid. Os instantes de
+ * cada pgina so escritos em relao ao incio dela, e a rgua  numerada a partir do incio
+ * (opo numoffset do rtsched). Sem janela nem pginas h um s RTGrid, de 0 ao horizonte.
+ *
+ * Os eventos devem chegar em ordem de tempo; as pginas so abertas conforme os eventos avanam e
+ * nunca so reabertas. Um trecho de execuo que cruza o limite de uma pgina aberta depois dele
+ *  recortado no incio da pgina atual, por isso quem gera os eventos deve dividir os trechos nos
+ * limites dados por paginador_quebra().
+ */
+
+#ifndef PAGINADOR_H_INCLUDED
+#define PAGINADOR_H_INCLUDED
+
+#include <inttypes.h>
+
+#include "anel.h"
+#include "saida.h"
+
+typedef struct paginadores paginador_t;
+
+/* Escreve o incio do documento .tex; fim  limitado ao horizonte, ticks = 0 para uma s pgina.
+ * ids: identificadores das numTarefas tarefas na ordem das linhas, copiados para os rtulos;
+ * nucleos: linhas de CPU abaixo das tarefas, numTarefas+1 a numTarefas+nucleos */
+paginador_t *cria_paginador(saida_t *saida, uint32_t numTarefas, uint32_t nucleos, const uint32_t *ids,
+                            uint64_t horizonte, uint64_t inicio, uint64_t fim, uint64_t ticks);
+
+/* Escreve as pginas que faltam e o fim do documento e libera o paginador - a sada continua aberta */
+void finaliza_paginador(paginador_t *paginador);
+
+/* Desenha o evento na sua pgina, recortado na janela - 1 se foi escrito, 0 se ficou de fora */
+int paginador_evento(paginador_t *paginador, const evento_t *evento);
+
+/* 1 se alguma parte do evento cai na janela. Usa somente os parmetros fixos do paginador e
+ * pode ser chamada por outra thread enquanto os eventos so escritos */
+int paginador_visivel(const paginador_t *paginador, const evento_t *evento);
+
+/* Primeiro limite entre duas pginas posterior a tempo, UINT64_MAX se no houver - tambm pode
+ * ser chamada por outra thread */
+uint64_t paginador_quebra(const paginador_t *paginador, uint64_t tempo);
+
+/* Janela efetivamente desenhada */
+uint64_t paginador_inicio(const paginador_t *paginador);
+uint64_t paginador_fim(const paginador_t *paginador);
+
+#endif // PAGINADOR_H_INCLUDED
@@ -0,0 +1,224 @@
+/** \file particao.c
+ * \brief   Partio das tarefas entre os ncleos (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "particao.h"
+#include "analise.h"
+#include "no.h"
+#include "tabela.h"
+#include "tarefas.h"
+
+struct particoes {
+    int nucleos;
+    lista_enc_t **listas;       // Tarefas de cada ncleo
+    double *utilizacao;         // Soma de Ci/Ti de cada ncleo
+    lista_enc_t *rejeitadas;    // Tarefas que nenhum ncleo admitiu
+};
+
+// Utilizao decrescente, comparada sem ponto flutuante: Ca/Ta > Cb/Tb se Ca*Tb > Cb*Ta
+static int compara_utilizacao(void *a, void *b)
+{
+    tarefa_t *ta = a, *tb = b;
+    unsigned __int128 ua, ub;
+
+    ua = (unsigned __int128) tarefa_get_duracao(ta)*tarefa_get_periodo(tb);
+    ub = (unsigned __int128) tarefa_get_duracao(tb)*tarefa_get_periodo(ta);
+
+    return ua > ub ? -1 : ua < ub;
+}
+
+// Teste de admisso do conjunto do ncleo, que j contm a tarefa candidata
+static int aprova(lista_enc_t *lista, ADMISSAO admissao, const politica_t *politica)
+{
+    VEREDITO veredito;
+
+    if (politica == &politica_edf)
+        veredito = analise_utilizacao_edf(lista, NULL);
+    else
+        veredito = analise_utilizacao(lista, NULL);
+    if (veredito != INCONCLUSIVO || admissao == ADMISSAO_UTILIZACAO)
+        return veredito == ESCALONAVEL;
+
+    return analise_exata(lista, politica, NULL) == ESCALONAVEL;
+}
+
+// Tenta colocar a tarefa no ncleo k: o n fica na lista somente se o ncleo a admitir
+static int admite(particao_t *p, int k, no_t *no, ADMISSAO admissao, const politica_t *politica)
+{
+    add_cauda(p->listas[k], no);
+    if (aprova(p->listas[k], admissao, politica))
+        return 1;
+
+    remover_no(p->listas[k], no);
+    return 0;
+}
+
+particao_t *cria_particao(arena_t *arena, lista_enc_t *listaTarefas, int nucleos, HEURISTICA heuristica,
+                          ADMISSAO admissao, const politica_t *politica)
+{
+    particao_t *p;
+    lista_enc_t *ordem;
+    tarefa_t *tarefa;
+    no_t *no;
+    int *indices;
+    int i, j, k, escolhido;
+
+    if (arena == NULL || listaTarefas == NULL || politica == NULL || nucleos < 1){
+        fprintf(stderr,"cria_particao: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    p = arena_aloca(arena, sizeof(particao_t));
+    p->nucleos = nucleos;
+    p->listas = arena_aloca(arena, (size_t) nucleos*sizeof(lista_enc_t*));
+    p->utilizacao = arena_aloca(arena, (size_t) nucleos*sizeof(double));
+    p->rejeitadas = cria_lista_enc_arena(arena);
+    for (k = 0; k < nucleos; k++){
+        p->listas[k] = cria_lista_enc_arena(arena);
+        p->utilizacao[k] = 0.0;
+    }
+
+    // Cpia da lista em utilizao decrescente; a ordenao  estvel, empates ficam na ordem do arquivo
+    ordem = cria_lista_enc_arena(arena);
+    for (no = obter_cabeca(listaTarefas); no; no = obtem_proximo(no))
+        add_cauda(ordem, cria_no_arena(arena, obter_dado(no)));
+    ordena_lista(ordem, compara_utilizacao);
+
+    indices = arena_aloca(arena, (size_t) nucleos*sizeof(int));
+
+    for (no = obter_cabeca(ordem); no; no = obtem_proximo(no)){
+        tarefa = obter_dado(no);
+
+        // Ordem em que os ncleos so tentados: o primeiro que admitir recebe a tarefa
+        for (k = 0; k < nucleos; k++){
+            indices[k] = k;
+            if (heuristica == PRIMEIRO_AJUSTE)
+                continue;
+            for (i = k; i > 0; i--){        // Insero estvel: empates ficam com o menor ncleo
+                j = indices[i - 1];
+                if (heuristica == MELHOR_AJUSTE ? p->utilizacao[j] >= p->utilizacao[k]
+                                                : p->utilizacao[j] <= p->utilizacao[k])
+                    break;
+                indices[i] = j;
+            }
+            indices[i] = k;
+        }
+
+        escolhido = -1;
+        for (i = 0; i < nucleos && escolhido < 0; i++)
+            if (admite(p, indices[i], cria_no_arena(arena, tarefa), admissao, politica))
+                escolhido = indices[i];
+
+        if (escolhido < 0){
+            add_cauda(p->rejeitadas, cria_no_arena(arena, tarefa));
+            continue;
+        }
+        p->utilizacao[escolhido] += (double) tarefa_get_duracao(tarefa)/tarefa_get_periodo(tarefa);
+    }
+
+    return p;
+}
+
+int particao_nucleos(particao_t *particao)
+{
+    if (particao == NULL){
+        fprintf(stderr,"particao_nucleos: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    return particao->nucleos;
+}
+
+lista_enc_t *particao_lista(particao_t *particao, int k)
+{
+    if (particao == NULL || k < 0 || k >= particao->nucleos){
+        fprintf(stderr,"particao_lista: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    return particao->listas[k];
+}
+
+double particao_utilizacao(particao_t *particao, int k)
+{
+    if (particao == NULL || k < 0 || k >= particao->nucleos){
+        fprintf(stderr,"particao_utilizacao: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    return particao->utilizacao[k];
+}
+
+lista_enc_t *particao_rejeitadas(particao_t *particao)
+{
+    if (particao == NULL){
+        fprintf(stderr,"particao_rejeitadas: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    return particao->rejeitadas;
+}
+
+static void imprime_ids(FILE *fp, lista_enc_t *lista)
+{
+    no_t *no;
+
+    for (no = obter_cabeca(lista); no; no = obtem_proximo(no))
+        fprintf(fp, " T%" PRIu32, tarefa_get_id((tarefa_t*) obter_dado(no)));
+    fprintf(fp, "\n");
+}
+
+void particao_imprime(FILE *fp, particao_t *particao)
+{
+    int k;
+
+    if (fp == NULL || particao == NULL){
+        fprintf(stderr,"particao_imprime: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    for (k = 0; k < particao->nucleos; k++){
+        fprintf(fp, "Nucleo %d: U = %.4f -", k + 1, particao->utilizacao[k]);
+        imprime_ids(fp, particao->listas[k]);
+    }
+    if (!lista_vazia(particao->rejeitadas)){
+        fprintf(fp, "Sem nucleo:");
+        imprime_ids(fp, particao->rejeitadas);
+    }
+}
+
+int particao_heuristica(const char *nome, HEURISTICA *heuristica)
+{
+    if (strcmp(nome, "ff") == 0)
+        *heuristica = PRIMEIRO_AJUSTE;
+    else if (strcmp(nome, "bf") == 0)
+        *heuristica = MELHOR_AJUSTE;
+    else if (strcmp(nome, "wf") == 0)
+        *heuristica = PIOR_AJUSTE;
+    else
+        return -1;
+
+    return 0;
+}
+
+int particao_admissao(const char *nome, ADMISSAO *admissao)
+{
+    if (strcmp(nome, "rta") == 0)
+        *admissao = ADMISSAO_RTA;
+    else if (strcmp(nome, "util") == 0)
+        *admissao = ADMISSAO_UTILIZACAO;
+    else
+        return -1;
+
+    return 0;
+}
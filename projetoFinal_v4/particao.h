@@ -0,0 +1,69 @@
+/** \file particao.h
+ * \brief   Cabealho da partio das tarefas entre os ncleos (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ * No escalonamento particionado cada tarefa fica presa a um ncleo, e cada ncleo  escalonado
+ * sozinho pela poltica escolhida. As tarefas so distribudas em ordem decrescente de utilizao
+ * (Ci/Ti) por uma heurstica de empacotamento, e uma tarefa s entra em um ncleo se o conjunto
+ * do ncleo continuar aprovado no teste de admisso.
+ */
+
+#ifndef PARTICAO_H_INCLUDED
+#define PARTICAO_H_INCLUDED
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "arena.h"
+#include "lista_enc.h"
+#include "politica.h"
+
+/** \enum HEURISTICA
+ * Heurstica de empacotamento, sempre com as tarefas em ordem decrescente de utilizao, sendo:
+ */
+typedef enum{
+    PRIMEIRO_AJUSTE,    ///< First-fit decreasing: o primeiro ncleo que admite a tarefa
+    MELHOR_AJUSTE,      ///< Best-fit decreasing: o ncleo mais carregado que admite a tarefa
+    PIOR_AJUSTE         ///< Worst-fit decreasing: o ncleo menos carregado que admite a tarefa
+} HEURISTICA;
+
+/** \enum ADMISSAO
+ * Teste que decide se um ncleo aceita mais uma tarefa, sendo:
+ */
+typedef enum{
+    ADMISSAO_RTA,       ///< Teste exato: RTA para RM/DM, demanda de processador (QPA) para EDF
+    ADMISSAO_UTILIZACAO ///< Limite de utilizao: Liu & Layland/hiperblico para RM/DM, U <= 1 para EDF
+} ADMISSAO;
+
+typedef struct particoes particao_t;
+
+/* Distribui as tarefas da lista entre os ncleos. As listas de cada ncleo, seus ns e a partio
+ * so alocados na arena; as tarefas so as mesmas da lista, que no  alterada */
+particao_t *cria_particao(arena_t *arena, lista_enc_t *listaTarefas, int nucleos, HEURISTICA heuristica,
+                          ADMISSAO admissao, const politica_t *politica);
+
+int particao_nucleos(particao_t *particao);
+
+/* Tarefas do ncleo k, fora da ordem de prioridade: ordene antes de criar a tabela */
+lista_enc_t *particao_lista(particao_t *particao, int k);
+
+/* Soma de Ci/Ti das tarefas do ncleo k */
+double particao_utilizacao(particao_t *particao, int k);
+
+/* Tarefas que nenhum ncleo admitiu - vazia se a partio foi completa */
+lista_enc_t *particao_rejeitadas(particao_t *particao);
+
+/* Escreve a utilizao e as tarefas de cada ncleo, e as tarefas que ficaram sem ncleo */
+void particao_imprime(FILE *fp, particao_t *particao);
+
+/* Busca uma heurstica pelo nome (ff, bf ou wf) - 0 se encontrou, -1 caso contrrio */
+int particao_heuristica(const char *nome, HEURISTICA *heuristica);
+
+/* Busca um teste de admisso pelo nome (rta ou util) - 0 se encontrou, -1 caso contrrio */
+int particao_admissao(const char *nome, ADMISSAO *admissao);
+
+#endif // PARTICAO_H_INCLUDED
@@ -0,0 +1,45 @@
+/** \file politica.c
+ * \brief   Polticas de escalonamento.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "politica.h"
+#include "tabela.h"
+
+static uint64_t chave_rm(tabela_t* tabela, int i)
+{
+    (void) tabela;                  // A prioridade fixa  o prprio ndice na ordem RM
+    return i;
+}
+
+static uint64_t chave_edf(tabela_t* tabela, int i)
+{
+    return tabela_prazo(tabela, i);
+}
+
+const politica_t politica_rm = { "rm", chave_rm };
+const politica_t politica_edf = { "edf", chave_edf };
+
+const politica_t* politica_busca(const char* nome)
+{
+    if(nome == NULL){
+        return NULL;
+    }
+
+    if(!strcmp(nome, politica_rm.nome)){
+        return &politica_rm;
+    }
+    if(!strcmp(nome, politica_edf.nome)){
+        return &politica_edf;
+    }
+
+    return NULL;
+}
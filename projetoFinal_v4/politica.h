@@ -0,0 +1,40 @@
+/** \file politica.h
+ * \brief   Cabealho das polticas de escalonamento.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#ifndef POLITICA_H_INCLUDED
+#define POLITICA_H_INCLUDED
+
+#include <inttypes.h>
+
+struct tabela;
+
+/** \struct politica politica.h "politica.h"
+ *   \brief Poltica de escalonamento
+ *
+ * Uma poltica  definida pela chave de cada tarefa na fila de prontas: a tarefa de menor chave
+ * executa, e empates ficam com o menor ndice da tabela. A chave  recalculada pelo escalonador
+ * sempre que a tarefa entra na fila ou termina um "job" e continua com outros pendentes.
+ */
+typedef struct politica {
+    const char* nome;                                   ///< Nome usado na linha de comando
+    uint64_t (*chave)(struct tabela* tabela, int i);    ///< Chave da tarefa i na fila de prontas
+} politica_t;
+
+extern const politica_t politica_rm;    ///< Rate Monotonic: prioridade fixa, dada pelo ndice na tabela
+extern const politica_t politica_edf;   ///< Earliest Deadline First: prioridade pelo prazo absoluto
+
+/// \brief Busca uma poltica pelo nome.
+/**
+ *  \param nome: nome da poltica ("rm" ou "edf")
+ *  \return ponteiro da poltica, ou NULL caso no exista
+ */
+const politica_t* politica_busca(const char* nome);
+
+#endif // POLITICA_H_INCLUDED
@@ -0,0 +1,179 @@
+/** \file renderiza.c
+ * \brief   Sadas geradas a partir do trao binrio.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "renderiza.h"
+#include "paginador.h"
+
+static const char *nomes[] = { "chegada;", "execucao;", "termino;" };
+
+uint64_t renderiza_latex(traco_t *traco, saida_t *saida, uint64_t inicio, uint64_t fim, uint64_t ticks)
+{
+    const traco_cabecalho_t *cabecalho;
+    const traco_tarefa_t *tarefas;
+    const evento_t *eventos;
+    evento_t evento;
+    paginador_t *paginador;
+    uint32_t *ids;
+    size_t i, j, n;
+    uint64_t escritos = 0;
+    uint64_t fimJanela;
+    uint32_t k, linhaCpu;
+    int cpu, tarefa;
+
+    if (traco == NULL || saida == NULL) {
+        fprintf(stderr, "renderiza_latex: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    cabecalho = traco_cabecalho(traco);
+    tarefas = traco_tarefas(traco);
+    eventos = traco_eventos(traco);
+    n = traco_num_eventos(traco);
+    linhaCpu = cabecalho->numTarefas + 1;
+
+    ids = malloc(((size_t) cabecalho->numTarefas + 1)*sizeof(uint32_t));
+    if (ids == NULL){
+        perror("renderiza_latex:");
+        exit(EXIT_FAILURE);
+    }
+    for (k = 0; k < cabecalho->numTarefas; k++)
+        ids[k] = tarefas[k].id;
+    paginador = cria_paginador(saida, cabecalho->numTarefas, 1, ids, cabecalho->horizonte, inicio, fim, ticks);
+    free(ids);
+
+    fimJanela = paginador_fim(paginador);
+    inicio = paginador_inicio(paginador);
+
+    // Uma pgina [inicio, fim] por vez: o primeiro evento  localizado por busca binria
+    for (;;){
+        fim = paginador_quebra(paginador, inicio);
+        if (fim > fimJanela)
+            fim = fimJanela;
+
+        for (i = traco_busca(traco, inicio); i < n && traco_chave(&eventos[i]) <= fim; i++){
+            evento = eventos[i];
+            if (evento.tipo != EVENTO_EXECUCAO){
+                if (evento.inicio == fim && fim != fimJanela)
+                    continue;   // Chegadas e trminos no limite pertencem  pgina seguinte
+            }else if (evento.inicio < inicio){
+                evento.inicio = inicio;     // A parte anterior j foi escrita na pgina anterior
+            }
+            escritos += paginador_evento(paginador, &evento);
+        }
+
+        // Trechos que comeam antes do fim da pgina e terminam depois: em uma s CPU h no
+        // mximo um de tarefa e um da linha da CPU, e so os primeiros de cada linha aps o fim
+        for (j = i, cpu = tarefa = 0; j < n && !(cpu && tarefa); j++){
+            if (eventos[j].tipo != EVENTO_EXECUCAO)
+                continue;
+            if (eventos[j].id == linhaCpu){
+                if (cpu)
+                    continue;
+                cpu = 1;
+            }else{
+                if (tarefa)
+                    continue;
+                tarefa = 1;
+            }
+            if (eventos[j].inicio < fim){
+                evento = eventos[j];
+                if (evento.inicio < inicio)
+                    evento.inicio = inicio;
+                evento.fim = fim;
+                escritos += paginador_evento(paginador, &evento);
+            }
+        }
+
+        if (fim >= fimJanela)
+            break;
+        inicio = fim;
+    }
+
+    finaliza_paginador(paginador);
+
+    return escritos;
+}
+
+static void linha_csv(saida_t *saida, const evento_t *evento, uint32_t linhaCpu)
+{
+    saida_cadeia(saida, nomes[evento->tipo]);
+    if (evento->id == linhaCpu)
+        saida_cadeia(saida, "CPU");
+    else
+        saida_inteiro(saida, evento->id);
+    saida_caractere(saida, ';');
+    saida_inteiro(saida, evento->inicio);
+    saida_caractere(saida, ';');
+    saida_inteiro(saida, evento->tipo == EVENTO_EXECUCAO ? evento->fim : evento->inicio);
+    saida_caractere(saida, '\n');
+}
+
+uint64_t renderiza_csv(traco_t *traco, saida_t *saida, uint64_t inicio, uint64_t fim)
+{
+    const evento_t *eventos;
+    evento_t evento;
+    size_t i, j, n;
+    uint32_t linhaCpu;
+    uint64_t escritos = 0;
+    int cpu, tarefa;
+
+    if (traco == NULL || saida == NULL){
+        fprintf(stderr, "renderiza_csv: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    eventos = traco_eventos(traco);
+    n = traco_num_eventos(traco);
+    linhaCpu = traco_cabecalho(traco)->numTarefas + 1;
+
+    saida_cadeia(saida, "evento;tarefa;inicio;fim\n");
+
+    for (i = traco_busca(traco, inicio); i < n && traco_chave(&eventos[i]) <= fim; i++){
+        evento = eventos[i];
+        if (evento.tipo > EVENTO_TERMINO)
+            continue;
+        if (evento.tipo == EVENTO_EXECUCAO && evento.inicio < inicio){
+            if (evento.fim == inicio)
+                continue;               // Termina no incio da janela: nada dele fica dentro
+            evento.inicio = inicio;
+        }
+        linha_csv(saida, &evento, linhaCpu);
+        escritos++;
+    }
+
+    // Trechos que comeam antes do fim da janela e terminam depois, recortados no fim como em
+    // renderiza_latex(): no mximo um de tarefa e um da linha da CPU
+    for (j = i, cpu = tarefa = 0; j < n && !(cpu && tarefa); j++){
+        if (eventos[j].tipo != EVENTO_EXECUCAO)
+            continue;
+        if (eventos[j].id == linhaCpu){
+            if (cpu)
+                continue;
+            cpu = 1;
+        }else{
+            if (tarefa)
+                continue;
+            tarefa = 1;
+        }
+        if (eventos[j].inicio < fim){
+            evento = eventos[j];
+            if (evento.inicio < inicio)
+                evento.inicio = inicio;
+            evento.fim = fim;
+            linha_csv(saida, &evento, linhaCpu);
+            escritos++;
+        }
+    }
+
+    return escritos;
+}
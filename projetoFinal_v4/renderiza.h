@@ -0,0 +1,53 @@
+/** \file renderiza.h
+ * \brief   Cabealho das sadas geradas a partir do trao binrio.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#ifndef RENDERIZA_H_INCLUDED
+#define RENDERIZA_H_INCLUDED
+
+#include <inttypes.h>
+
+#include "anel.h"
+#include "saida.h"
+#include "traco.h"
+
+/// \brief Gera o Diagrama de Gannt (.tex) de uma janela do trao, dividida em pginas.
+/**
+ *  \param traco: trao aberto por abre_traco()
+ *  \param saida: sada bufferizada do arquivo .tex
+ *  \param inicio: primeiro instante da janela
+ *  \param fim: ltimo instante da janela, UINT64_MAX para o trao inteiro
+ *  \param ticks: ticks por pgina, 0 para uma s pgina
+ *  \return nmero de eventos escritos
+ *  \sa renderiza_csv(), traco_busca(), cria_paginador()
+ *
+ * A janela  limitada ao horizonte gravado no trao. O primeiro evento de cada pgina  localizado
+ * por busca binria, sem percorrer o incio do trao, e os trechos de execuo que cruzam os limites
+ * so recortados. Para o trao inteiro em uma pgina o arquivo  idntico ao escrito durante a
+ * simulao.
+ */
+uint64_t renderiza_latex(traco_t *traco, saida_t *saida, uint64_t inicio, uint64_t fim, uint64_t ticks);
+
+/// \brief Gera a lista de eventos em texto separado por ';' a partir de um trao.
+/**
+ *  \param traco: trao aberto por abre_traco()
+ *  \param saida: sada bufferizada do arquivo .csv
+ *  \param inicio: primeiro instante da janela
+ *  \param fim: ltimo instante da janela, UINT64_MAX para o trao inteiro
+ *  \return nmero de eventos escritos
+ *  \sa renderiza_latex(), traco_busca()
+ *
+ * Uma linha de cabealho "evento;tarefa;inicio;fim" e uma linha por evento, na ordem do trao:
+ * "chegada", "execucao" ou "termino", o id da tarefa ou "CPU", e os instantes - chegadas e
+ * trminos repetem o instante nos dois campos. Os trechos de execuo que cruzam os limites da
+ * janela so recortados neles.
+ */
+uint64_t renderiza_csv(traco_t *traco, saida_t *saida, uint64_t inicio, uint64_t fim);
+
+#endif // RENDERIZA_H_INCLUDED
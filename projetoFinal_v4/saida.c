@@ -0,0 +1,162 @@
+/** \file saida.c
+ * \brief   Funes para escrita bufferizada de arquivos de sada (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#define open(n, f, m)   _open(n, (f) | _O_BINARY, m)
+#define write           _write
+#define close           _close
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "saida.h"
+
+#define MAX_DIGITOS     20      // UINT64_MAX tem 20 dgitos decimais
+
+struct saidas {
+    int fd;
+    int erro;                   // Alguma escrita falhou
+    size_t usado;
+    size_t capacidade;
+    char *buffer;
+};
+
+saida_t *cria_saida(const char *arquivo)
+{
+    saida_t *p;
+    int fd;
+
+    if (arquivo == NULL){
+        fprintf(stderr,"cria_saida: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    fd = open(arquivo, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return NULL;
+
+    p = malloc(sizeof(saida_t));
+    if (p == NULL){
+        perror("cria_saida:");
+        exit(EXIT_FAILURE);
+    }
+
+    p->buffer = malloc(SAIDA_BUFFER_PADRAO);
+    if (p->buffer == NULL){
+        perror("cria_saida:");
+        exit(EXIT_FAILURE);
+    }
+
+    p->fd = fd;
+    p->erro = 0;
+    p->usado = 0;
+    p->capacidade = SAIDA_BUFFER_PADRAO;
+
+    return p;
+}
+
+// Envia tamanho bytes ao arquivo, repetindo o write() at o fim ou at um erro
+static void escreve(saida_t *saida, const char *p, size_t tamanho)
+{
+    long escrito;
+
+    while (tamanho > 0 && !saida->erro){
+        escrito = write(saida->fd, p, tamanho);
+        if (escrito < 0){
+            if (errno != EINTR)
+                saida->erro = 1;
+            continue;
+        }
+        p += escrito;
+        tamanho -= escrito;
+    }
+}
+
+int saida_descarrega(saida_t *saida)
+{
+    if (saida == NULL){
+        fprintf(stderr,"saida_descarrega: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    escreve(saida, saida->buffer, saida->usado);
+    saida->usado = 0;
+
+    return saida->erro ? -1 : 0;
+}
+
+int fecha_saida(saida_t *saida)
+{
+    int resultado;
+
+    if (saida == NULL){
+        fprintf(stderr,"fecha_saida: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    resultado = saida_descarrega(saida);
+    if (close(saida->fd) < 0)
+        resultado = -1;
+
+    free(saida->buffer);
+    free(saida);
+
+    return resultado;
+}
+
+void saida_texto(saida_t *saida, const char *texto, size_t tamanho)
+{
+    if (saida->usado + tamanho > saida->capacidade){
+        saida_descarrega(saida);
+        if (tamanho >= saida->capacidade){      // No cabe no buffer: vai direto para o arquivo
+            escreve(saida, texto, tamanho);
+            return;
+        }
+    }
+
+    memcpy(saida->buffer + saida->usado, texto, tamanho);
+    saida->usado += tamanho;
+}
+
+void saida_cadeia(saida_t *saida, const char *cadeia)
+{
+    saida_texto(saida, cadeia, strlen(cadeia));
+}
+
+void saida_caractere(saida_t *saida, char c)
+{
+    if (saida->usado == saida->capacidade)
+        saida_descarrega(saida);
+
+    saida->buffer[saida->usado++] = c;
+}
+
+void saida_inteiro(saida_t *saida, uint64_t valor)
+{
+    char digitos[MAX_DIGITOS];
+    char *p = digitos + MAX_DIGITOS;
+
+    // Dgitos gerados do menos para o mais significativo, do fim para o incio
+    do{
+        *--p = (char) ('0' + valor%10);
+        valor /= 10;
+    }while (valor);
+
+    saida_texto(saida, p, digitos + MAX_DIGITOS - p);
+}
@@ -0,0 +1,39 @@
+/** \file saida.h
+ * \brief   Cabealho de funes para escrita bufferizada de arquivos de sada (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ * O texto  montado em um buffer grande na memria e enviado ao arquivo com write() somente
+ * quando o buffer enche ou a sada  fechada. Os inteiros so convertidos para decimal sem
+ * passar por printf, e nenhuma trava da biblioteca padro  usada.
+ */
+
+#ifndef SAIDA_H_INCLUDED
+#define SAIDA_H_INCLUDED
+
+#include <stddef.h>
+#include <inttypes.h>
+
+#define SAIDA_BUFFER_PADRAO     (1 << 20)   // Tamanho do buffer em bytes
+
+typedef struct saidas saida_t;
+
+/* Cria o arquivo, truncando se existir - NULL em caso de erro, com errno preenchido */
+saida_t *cria_saida(const char *arquivo);
+
+/* Descarrega o buffer, fecha o arquivo e libera a sada
+ * 0 em caso de sucesso, -1 se alguma escrita ou o fechamento falhou */
+int fecha_saida(saida_t *saida);
+
+/* Escreve o contedo do buffer no arquivo - 0 ou -1 em caso de erro */
+int saida_descarrega(saida_t *saida);
+
+void saida_texto(saida_t *saida, const char *texto, size_t tamanho);
+void saida_cadeia(saida_t *saida, const char *cadeia);
+void saida_caractere(saida_t *saida, char c);
+void saida_inteiro(saida_t *saida, uint64_t valor);
+
+#endif // SAIDA_H_INCLUDED
@@ -0,0 +1,441 @@
+/** \file tabela.c
+ * \brief   Tabela de tarefas usada pelo escalonador.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "tabela.h"
+
+// Arredonda tamanho para o prximo mltiplo da linha de cache
+static size_t alinha(size_t tamanho)
+{
+    return (tamanho + TABELA_ALINHAMENTO - 1) & ~((size_t) TABELA_ALINHAMENTO - 1);
+}
+
+tabela_t* cria_tabela(lista_enc_t* listaTarefas)
+{
+    tabela_t* p_tabela;
+    tarefa_t* p_tarefa;
+    no_t* p_no;
+    unsigned char* base;
+    size_t n, total;
+    int i;
+
+    if (listaTarefas == NULL) {
+        fprintf(stderr, "cria_tabela: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    p_tabela = (tabela_t*) malloc(sizeof(tabela_t));
+    if(p_tabela == NULL){
+        perror("Erro ao alocar tabela:");
+        exit(EXIT_FAILURE);
+    }
+
+    n = tamanho_lista(listaTarefas);
+    p_tabela->n = n;
+
+    // Um nico bloco para todos os vetores, cada um comeando em uma linha de cache
+    total = 17*alinha(n*sizeof(uint64_t)) + 3*alinha(n*sizeof(uint32_t)) + alinha(n*sizeof(uint8_t));
+    p_tabela->tamanhoMemoria = total + TABELA_ALINHAMENTO;
+    p_tabela->memoria = malloc(p_tabela->tamanhoMemoria);
+    if(p_tabela->memoria == NULL){
+        perror("Erro ao alocar tabela:");
+        exit(EXIT_FAILURE);
+    }
+
+    base = (unsigned char*) alinha((uintptr_t) p_tabela->memoria);
+    p_tabela->periodo = (uint64_t*) base;         base += alinha(n*sizeof(uint64_t));
+    p_tabela->duracao = (uint64_t*) base;         base += alinha(n*sizeof(uint64_t));
+    p_tabela->prazo = (uint64_t*) base;           base += alinha(n*sizeof(uint64_t));
+    p_tabela->fase = (uint64_t*) base;            base += alinha(n*sizeof(uint64_t));
+    p_tabela->proximaChegada = (uint64_t*) base;  base += alinha(n*sizeof(uint64_t));
+    p_tabela->restante = (uint64_t*) base;        base += alinha(n*sizeof(uint64_t));
+    p_tabela->inicio = (uint64_t*) base;          base += alinha(n*sizeof(uint64_t));
+    p_tabela->maiorAtraso = (uint64_t*) base;     base += alinha(n*sizeof(uint64_t));
+    p_tabela->atrasoTotal = (uint64_t*) base;     base += alinha(n*sizeof(uint64_t));
+    p_tabela->concluidos = (uint64_t*) base;      base += alinha(n*sizeof(uint64_t));
+    p_tabela->respostaMin = (uint64_t*) base;     base += alinha(n*sizeof(uint64_t));
+    p_tabela->respostaMax = (uint64_t*) base;     base += alinha(n*sizeof(uint64_t));
+    p_tabela->respostaSoma = (uint64_t*) base;    base += alinha(n*sizeof(uint64_t));
+    p_tabela->latenciaMin = (uint64_t*) base;     base += alinha(n*sizeof(uint64_t));
+    p_tabela->latenciaMax = (uint64_t*) base;     base += alinha(n*sizeof(uint64_t));
+    p_tabela->preempcoes = (uint64_t*) base;      base += alinha(n*sizeof(uint64_t));
+    p_tabela->migracoes = (uint64_t*) base;       base += alinha(n*sizeof(uint64_t));
+    p_tabela->nmrExe = (uint32_t*) base;          base += alinha(n*sizeof(uint32_t));
+    p_tabela->perdas = (uint32_t*) base;          base += alinha(n*sizeof(uint32_t));
+    p_tabela->id = (uint32_t*) base;              base += alinha(n*sizeof(uint32_t));
+    p_tabela->estado = (uint8_t*) base;
+
+    p_no = obter_cabeca(listaTarefas);
+    for(i = 0; p_no; i++){
+        p_tarefa = (tarefa_t*) obter_dado(p_no);
+        p_tabela->id[i] = tarefa_get_id(p_tarefa);
+        p_tabela->periodo[i] = tarefa_get_periodo(p_tarefa);
+        p_tabela->duracao[i] = tarefa_get_duracao(p_tarefa);
+        p_tabela->prazo[i] = tarefa_get_prazo(p_tarefa);
+        p_tabela->fase[i] = tarefa_get_fase(p_tarefa);
+        p_tabela->proximaChegada[i] = p_tabela->fase[i];
+        p_tabela->restante[i] = p_tabela->duracao[i];
+        p_tabela->inicio[i] = 0;
+        p_tabela->nmrExe[i] = 0;
+        p_tabela->perdas[i] = 0;
+        p_tabela->maiorAtraso[i] = 0;
+        p_tabela->atrasoTotal[i] = 0;
+        p_tabela->concluidos[i] = 0;
+        p_tabela->respostaMin[i] = UINT64_MAX;
+        p_tabela->respostaMax[i] = 0;
+        p_tabela->respostaSoma[i] = 0;
+        p_tabela->latenciaMin[i] = UINT64_MAX;
+        p_tabela->latenciaMax[i] = 0;
+        p_tabela->preempcoes[i] = 0;
+        p_tabela->migracoes[i] = 0;
+        p_tabela->estado[i] = PRONTA;
+        p_no = obtem_proximo(p_no);
+    }
+
+    p_tabela->tempoSimulado = 0;
+    p_tabela->tempoOcupado = 0;
+    p_tabela->nucleos = 1;
+
+    return p_tabela;
+}
+
+void desaloca_tabela(tabela_t* tabela)
+{
+    if (tabela == NULL) {
+        fprintf(stderr, "desaloca_tabela: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    free(tabela->memoria);
+    free(tabela);
+}
+
+void* tabela_salva(tabela_t* tabela)
+{
+    unsigned char* copia;
+
+    if (tabela == NULL) {
+        fprintf(stderr, "tabela_salva: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Os ponteiros dos vetores continuam vlidos na restaurao: o bloco volta para o mesmo lugar
+    copia = malloc(sizeof(tabela_t) + tabela->tamanhoMemoria);
+    if(copia == NULL){
+        perror("tabela_salva:");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(copia, tabela, sizeof(tabela_t));
+    memcpy(copia + sizeof(tabela_t), tabela->memoria, tabela->tamanhoMemoria);
+
+    return copia;
+}
+
+void tabela_restaura(tabela_t* tabela, void* copia)
+{
+    if (tabela == NULL || copia == NULL) {
+        fprintf(stderr, "tabela_restaura: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(tabela, copia, sizeof(tabela_t));
+    memcpy(tabela->memoria, (unsigned char*) copia + sizeof(tabela_t), tabela->tamanhoMemoria);
+    free(copia);
+}
+
+void tabela_agenda(tabela_t* tabela, calendario_t* calendario)
+{
+    int i;
+
+    if (tabela == NULL || calendario == NULL) {
+        fprintf(stderr, "tabela_agenda: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(i = 0; i < tabela->n; i++){
+        calendario_agenda(calendario, tabela->proximaChegada[i], i);
+    }
+}
+
+void tabela_update(tabela_t* tabela, calendario_t* calendario, calendario_t* prazos, fila_prio_t* filaProntas,
+                   const politica_t* politica, uint64_t tempo, escritor_t *escritor)
+{
+    int i;
+
+    if (tabela == NULL || calendario == NULL || filaProntas == NULL || politica == NULL) {
+        fprintf(stderr, "tabela_update: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Somente as tarefas agendadas para este instante so visitadas, em ordem de prioridade
+    while((i = calendario_retira(calendario, tempo)) >= 0){
+        tabela->nmrExe[i]++;
+        // Desenha seta para cima
+        escritor_chegada(escritor, tabela->id[i], tempo);
+        tabela->proximaChegada[i] = tempo + tabela->periodo[i];
+        if(tabela->estado[i] == OCIOSA){
+            tabela->estado[i] = PRONTA;
+        }
+        if(!fila_prio_contem(filaProntas, i)){
+            fila_prio_insere(filaProntas, i, politica->chave(tabela, i));
+        }
+        if(tempo <= UINT64_MAX - tabela->periodo[i]){    // Chegada alm de 64 bits nunca acontece
+            calendario_agenda(calendario, tabela->proximaChegada[i], i);
+        }
+        if(prazos && tempo <= UINT64_MAX - tabela->prazo[i]){
+            calendario_agenda(prazos, tempo + tabela->prazo[i], i);
+        }
+    }
+}
+
+int tabela_checa_prazos(tabela_t* tabela, calendario_t* prazos, uint64_t tempo)
+{
+    int i, perdas;
+
+    if (tabela == NULL || prazos == NULL) {
+        fprintf(stderr, "tabela_checa_prazos: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    perdas = 0;
+    while((i = calendario_retira(prazos, tempo)) >= 0){
+        // Os "jobs" terminam em ordem: o "job" deste prazo est pendente se o mais antigo vence at agora
+        if(tabela->nmrExe[i] && tabela_prazo(tabela, i) <= tempo){
+            tabela->perdas[i]++;
+            perdas++;
+        }
+    }
+
+    return perdas;
+}
+
+void tabela_set_inicio(tabela_t* tabela, int i, uint64_t tempo)
+{
+    uint64_t espera;
+
+    if (tabela == NULL) {
+        fprintf(stderr, "tabela_set_inicio: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if(tabela->restante[i] == tabela->duracao[i]){      // Primeiro incio do "job"
+        espera = tempo - (tabela->proximaChegada[i] - (uint64_t) tabela->nmrExe[i]*tabela->periodo[i]);
+        if(espera < tabela->latenciaMin[i]) tabela->latenciaMin[i] = espera;
+        if(espera > tabela->latenciaMax[i]) tabela->latenciaMax[i] = espera;
+    }
+
+    tabela->inicio[i] = tempo;
+    tabela->estado[i] = EXECUTANDO;
+}
+
+void tabela_set_pausa(tabela_t* tabela, int i, uint64_t tempo)
+{
+    if (tabela == NULL) {
+        fprintf(stderr, "tabela_set_pausa: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    tabela->restante[i] -= tempo - tabela->inicio[i];
+    tabela->estado[i] = PARADA;
+    tabela->preempcoes[i]++;
+}
+
+int tabela_checa_termino(tabela_t* tabela, fila_prio_t* filaProntas, const politica_t* politica, int i, uint64_t tempo)
+{
+    uint64_t prazo, resposta;
+
+    if (tabela == NULL || filaProntas == NULL || politica == NULL) {
+        fprintf(stderr, "tabela_checa_termino: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if(tempo - tabela->inicio[i] == tabela->restante[i]){
+        prazo = tabela_prazo(tabela, i);
+        resposta = tempo - (prazo - tabela->prazo[i]);
+        tabela->concluidos[i]++;
+        tabela->respostaSoma[i] += resposta;
+        if(resposta < tabela->respostaMin[i]) tabela->respostaMin[i] = resposta;
+        if(resposta > tabela->respostaMax[i]) tabela->respostaMax[i] = resposta;
+        if(tempo > prazo){
+            tabela->atrasoTotal[i] += tempo - prazo;
+            if(tempo - prazo > tabela->maiorAtraso[i]){
+                tabela->maiorAtraso[i] = tempo - prazo;
+            }
+        }
+        tabela->nmrExe[i]--;
+        tabela->restante[i] = tabela->duracao[i];
+        if(!tabela->nmrExe[i]){    // Se a tarefa no tiver mais execues na fila
+            tabela->estado[i] = OCIOSA;
+            fila_prio_remove(filaProntas, i);
+        }else{
+            tabela->estado[i] = PRONTA;
+            fila_prio_atualiza(filaProntas, i, politica->chave(tabela, i));
+        }
+        return 1;
+    }
+
+    return 0;
+}
+
+void tabela_encerra(tabela_t* tabela, uint64_t fim)
+{
+    uint64_t chegada, prazo, restante;
+    uint32_t k;
+    int i;
+
+    if (tabela == NULL) {
+        fprintf(stderr, "tabela_encerra: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(i = 0; i < tabela->n; i++){
+        if(!tabela->nmrExe[i]){
+            continue;
+        }
+        // Os "jobs" da tarefa terminam em ordem: o k-simo pendente ainda precisa do que resta
+        // do mais antigo e de mais k duraes inteiras, e no termina antes de fim + isso
+        restante = tabela->restante[i];
+        if(tabela->estado[i] == EXECUTANDO){
+            restante -= fim - tabela->inicio[i];
+        }
+        chegada = tabela->proximaChegada[i] - (uint64_t) tabela->nmrExe[i]*tabela->periodo[i];
+        for(k = 0; k < tabela->nmrExe[i]; k++){
+            prazo = chegada + (uint64_t) k*tabela->periodo[i] + tabela->prazo[i];
+            if(prazo > fim){            // Ainda no prazo: no  perda
+                break;
+            }
+            tabela->atrasoTotal[i] += fim - prazo + restante;
+            if(fim - prazo + restante > tabela->maiorAtraso[i]){
+                tabela->maiorAtraso[i] = fim - prazo + restante;
+            }
+            restante += tabela->duracao[i];
+        }
+    }
+}
+
+uint64_t tabela_previsao_termino(tabela_t* tabela, int i)
+{
+    if (tabela == NULL) {
+        fprintf(stderr, "tabela_previsao_termino: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return tabela->inicio[i] + tabela->restante[i];
+}
+
+uint64_t tabela_prazo(tabela_t* tabela, int i)
+{
+    if (tabela == NULL) {
+        fprintf(stderr, "tabela_prazo: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // O "job" pendente mais antigo chegou nmrExe perodos antes da prxima chegada
+    return tabela->proximaChegada[i] - (uint64_t) tabela->nmrExe[i]*tabela->periodo[i] + tabela->prazo[i];
+}
+
+uint64_t tabela_imprime_perdas(FILE *fp, tabela_t* tabela)
+{
+    uint64_t total;
+    int i;
+
+    if (fp == NULL || tabela == NULL) {
+        fprintf(stderr, "tabela_imprime_perdas: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    total = 0;
+    for(i = 0; i < tabela->n; i++){
+        total += tabela->perdas[i];
+    }
+
+    if(!total){
+        fprintf(fp, "Nenhum prazo perdido.\n");
+        return 0;
+    }
+
+    fprintf(fp, "Prazos perdidos: %" PRIu64 "\n", total);
+    for(i = 0; i < tabela->n; i++){
+        if(tabela->perdas[i]){
+            fprintf(fp, "T%" PRIu32 "\tperdas: %" PRIu32 "\tatraso maximo: %" PRIu64 "\tatraso total: %" PRIu64 "\n",
+                    tabela->id[i], tabela->perdas[i], tabela->maiorAtraso[i], tabela->atrasoTotal[i]);
+        }
+    }
+
+    return total;
+}
+
+void tabela_imprime_estatisticas(FILE *fp, tabela_t* tabela)
+{
+    int i;
+
+    if (fp == NULL || tabela == NULL) {
+        fprintf(stderr, "tabela_imprime_estatisticas: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // A coluna de migraes s existe no escalonamento global
+    if(tabela->nucleos > 1){
+        fprintf(fp, "id;jobs;Rmin;Rmed;Rmax;preempcoes;migracoes;jitter;perdas;atraso\n");
+    }else{
+        fprintf(fp, "id;jobs;Rmin;Rmed;Rmax;preempcoes;jitter;perdas;atraso\n");
+    }
+    for(i = 0; i < tabela->n; i++){
+        fprintf(fp, "T%" PRIu32 ";%" PRIu64 ";", tabela->id[i], tabela->concluidos[i]);
+        if(tabela->concluidos[i]){
+            fprintf(fp, "%" PRIu64 ";%.3f;%" PRIu64 ";", tabela->respostaMin[i],
+                    (double) tabela->respostaSoma[i]/tabela->concluidos[i], tabela->respostaMax[i]);
+        }else{
+            fprintf(fp, "-;-;-;");
+        }
+        fprintf(fp, "%" PRIu64 ";", tabela->preempcoes[i]);
+        if(tabela->nucleos > 1){
+            fprintf(fp, "%" PRIu64 ";", tabela->migracoes[i]);
+        }
+        if(tabela->latenciaMin[i] != UINT64_MAX){
+            fprintf(fp, "%" PRIu64 ";", tabela->latenciaMax[i] - tabela->latenciaMin[i]);
+        }else{
+            fprintf(fp, "-;");
+        }
+        fprintf(fp, "%" PRIu32 ";%" PRIu64 "\n", tabela->perdas[i], tabela->maiorAtraso[i]);
+    }
+
+    fprintf(fp, "CPU;ociosa;");
+    if(tabela->tempoSimulado){
+        fprintf(fp, "%.6f\n", 1.0 - (double) tabela->tempoOcupado/((double) tabela->tempoSimulado*tabela->nucleos));
+    }else{
+        fprintf(fp, "-\n");
+    }
+}
+
+void imprime_tabela(tabela_t* tabela)
+{
+    char estados[4][20] = { {"Ociosa"},
+                            {"Executando"},
+                            {"Pronta"},
+                            {"Parada"}
+                          };
+    int i;
+
+    if (tabela == NULL) {
+        fprintf(stderr, "imprime_tabela: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(i = 0; i < tabela->n; i++){
+        printf("Tarefa %" PRIu32 " - Estado %s \t", tabela->id[i], estados[tabela->estado[i]]);
+        printf("C: %" PRIu64 " - T: %" PRIu64 " - D: %" PRIu64 "\n", tabela->duracao[i], tabela->periodo[i], tabela->prazo[i]);
+    }
+}
@@ -0,0 +1,239 @@
+/** \file tabela.h
+ * \brief   Cabealho da tabela de tarefas usada pelo escalonador.
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#ifndef TABELA_H_INCLUDED
+#define TABELA_H_INCLUDED
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "lista_enc.h"
+#include "fila_prio.h"
+#include "calendario.h"
+#include "politica.h"
+#include "escritor.h"
+#include "tarefas.h"
+
+#define TABELA_ALINHAMENTO  64      // Tamanho da linha de cache
+
+/** \struct tabela tabela.h "tabela.h"
+ *   \brief Tabela de tarefas organizada como vetores paralelos
+ *
+ * A tarefa de ndice i ocupa a posio i de todos os vetores. Os ndices seguem a ordem da lista
+ * usada na criao, portanto com a lista ordenada o ndice tambm  a prioridade da tarefa
+ * (0  a mais prioritria). Todos os vetores ficam em um nico bloco de memria, cada um comeando
+ * em uma linha de cache, e a estrutura  exposta para que o lao de simulao os acesse sem
+ * passar pelos ns da lista.
+ */
+typedef struct tabela {
+    int n;                      ///< Nmero de tarefas
+    uint32_t *id;               ///< Identificador da tarefa
+    uint64_t *periodo;          ///< Perodo - T
+    uint64_t *duracao;          ///< Durao - C
+    uint64_t *prazo;            ///< Prazo relativo - D
+    uint64_t *fase;             ///< Instante da primeira chegada - O
+    uint64_t *proximaChegada;   ///< Instante da prxima requisio
+    uint64_t *restante;         ///< Tempo que falta para o "job" atual terminar
+    uint64_t *inicio;           ///< Instante em que o trecho de execuo atual comeou
+    uint32_t *nmrExe;           ///< Quantos "jobs" esto na fila
+    uint32_t *perdas;           ///< Quantos "jobs" perderam o prazo
+    uint64_t *maiorAtraso;      ///< Maior atraso (trmino - prazo), com o mnimo dos pendentes no fim da simulao
+    uint64_t *atrasoTotal;      ///< Soma dos atrasos, com o mnimo dos pendentes no fim da simulao
+    uint64_t *concluidos;       ///< Quantos "jobs" terminaram
+    uint64_t *respostaMin;      ///< Menor tempo de resposta (trmino - chegada)
+    uint64_t *respostaMax;      ///< Maior tempo de resposta
+    uint64_t *respostaSoma;     ///< Soma dos tempos de resposta, para a mdia
+    uint64_t *latenciaMin;      ///< Menor espera entre a chegada e o primeiro incio de um "job"
+    uint64_t *latenciaMax;      ///< Maior espera entre a chegada e o primeiro incio de um "job"
+    uint64_t *preempcoes;       ///< Quantas vezes a tarefa foi interrompida por outra
+    uint64_t *migracoes;        ///< Quantas vezes um "job" interrompido continuou em outro ncleo
+    uint64_t tempoSimulado;     ///< Durao do intervalo simulado
+    uint64_t tempoOcupado;      ///< Parte do intervalo simulado em que a CPU executou alguma tarefa, somada entre os ncleos
+    int nucleos;                ///< Ncleos que executaram a tabela: 1, ou m no escalonamento global
+    uint8_t *estado;            ///< ESTADO_TAREFA da tarefa
+    void *memoria;              ///< Bloco que contm todos os vetores
+    size_t tamanhoMemoria;      ///< Tamanho do bloco, para tabela_salva()
+} tabela_t;
+
+/// \brief Cria a tabela a partir de uma lista de tarefas.
+/**
+ *  \param listaTarefas: ponteiro da lista de tarefas, normalmente j ordenada
+ *  \return Um ponteiro alocado do tipo tabela_t
+ *  \sa ordena_tarefas(), desaloca_tabela()
+ */
+tabela_t* cria_tabela(lista_enc_t* listaTarefas);
+
+/// \brief Desaloca a tabela de tarefas.
+/**
+ *  \param tabela: ponteiro da tabela
+ *  \return vazio
+ *  \sa cria_tabela()
+ */
+void desaloca_tabela(tabela_t* tabela);
+
+/// \brief Guarda uma cpia de todos os vetores e contadores da tabela.
+/**
+ *  \param tabela: ponteiro da tabela
+ *  \return cpia alocada, a ser passada para tabela_restaura()
+ *  \sa tabela_restaura()
+ */
+void* tabela_salva(tabela_t* tabela);
+
+/// \brief Devolve a tabela ao estado guardado por tabela_salva() e libera a cpia.
+/**
+ *  \param tabela: a mesma tabela passada para tabela_salva()
+ *  \param copia: cpia retornada por tabela_salva()
+ *  \return vazio
+ *  \sa tabela_salva()
+ */
+void tabela_restaura(tabela_t* tabela, void* copia);
+
+/// \brief Agenda a primeira chegada, no instante da fase (O), de todas as tarefas da tabela.
+/**
+ *  \param tabela: ponteiro da tabela
+ *  \param calendario: calendrio de chegadas
+ *  \return vazio
+ *  \sa tabela_update()
+ */
+void tabela_agenda(tabela_t* tabela, calendario_t* calendario);
+
+/// \brief Verifica requisio de tarefas no instante indicado.
+/**
+ *  \param tabela: ponteiro da tabela
+ *  \param calendario: calendrio com a prxima chegada de cada tarefa
+ *  \param prazos: calendrio que recebe o prazo de cada "job" requisitado, pode ser NULL
+ *  \param filaProntas: fila de prontas onde as tarefas requisitadas so inseridas
+ *  \param politica: poltica que define a chave de cada tarefa na fila
+ *  \param tempo: instante atual
+ *  \param escritor: escritor dos eventos do Diagrama de Gannt
+ *  \return vazio
+ *  \sa tabela_agenda(), tabela_checa_termino()
+ *
+ * Cada tarefa requisitada  reagendada no calendrio para tempo + perodo.
+ */
+void tabela_update(tabela_t* tabela, calendario_t* calendario, calendario_t* prazos, fila_prio_t* filaProntas,
+                   const politica_t* politica, uint64_t tempo, escritor_t *escritor);
+
+/// \brief Verifica os prazos que vencem no instante indicado.
+/**
+ *  \param tabela: ponteiro da tabela
+ *  \param prazos: calendrio de prazos preenchido por tabela_update()
+ *  \param tempo: instante atual, depois de tratados os trminos deste instante
+ *  \return nmero de "jobs" que perderam o prazo neste instante
+ *  \sa tabela_update(), tabela_prazo()
+ *
+ * Um prazo  perdido quando o "job" ainda est pendente no instante do prazo. A perda  contada
+ * em perdas[] nesse momento; o atraso  contabilizado quando o "job" termina, ou por
+ * tabela_encerra() se ele no terminar at o fim da simulao.
+ */
+int tabela_checa_prazos(tabela_t* tabela, calendario_t* prazos, uint64_t tempo);
+
+/// \brief Contabiliza o atraso dos "jobs" que perderam o prazo e no terminaram at o fim da simulao.
+/**
+ *  \param tabela: ponteiro da tabela, no estado do fim da simulao
+ *  \param fim: ltimo instante simulado, j verificado por tabela_checa_prazos()
+ *  \return vazio
+ *  \sa tabela_checa_prazos()
+ *
+ * O trmino de cada um  desconhecido; entra o menor possvel, com o que resta do "job" executado
+ * sem interrupo a partir de fim, para que o atraso de uma perda nunca aparea como zero.
+ */
+void tabela_encerra(tabela_t* tabela, uint64_t fim);
+
+/// \brief Estabelece o tempo de incio de execuo da tarefa i.
+/**
+ *  \param tabela: ponteiro da tabela
+ *  \param i: ndice da tarefa
+ *  \param tempo: instante de incio
+ *  \return vazio
+ *  \sa tabela_set_pausa(), tabela_checa_termino()
+ *
+ * No primeiro incio de cada "job" a espera desde a chegada  registrada em latenciaMin[] e latenciaMax[].
+ */
+void tabela_set_inicio(tabela_t* tabela, int i, uint64_t tempo);
+
+/// \brief Interrompe a execuo da tarefa i, descontando o tempo executado.
+/**
+ *  \param tabela: ponteiro da tabela
+ *  \param i: ndice da tarefa
+ *  \param tempo: instante da interrupo
+ *  \return vazio
+ *  \sa tabela_set_inicio(), tabela_checa_termino()
+ *
+ * Cada interrupo  contada em preempcoes[].
+ */
+void tabela_set_pausa(tabela_t* tabela, int i, uint64_t tempo);
+
+/// \brief Verifica se o "job" atual da tarefa i terminou.
+/**
+ *  \param tabela: ponteiro da tabela
+ *  \param filaProntas: fila de prontas, de onde a tarefa sai caso fique ociosa
+ *  \param politica: poltica que define a chave do prximo "job" pendente
+ *  \param i: ndice da tarefa
+ *  \param tempo: instante verificado
+ *  \return 0: tarefa no terminada; 1: tarefa terminada
+ *  \sa tabela_set_inicio(), tabela_previsao_termino()
+ *
+ * O tempo de resposta do "job"  acumulado em respostaMin[], respostaMax[] e respostaSoma[], e se
+ * o "job" termina depois do prazo o atraso  somado em atrasoTotal[] e maiorAtraso[].
+ */
+int tabela_checa_termino(tabela_t* tabela, fila_prio_t* filaProntas, const politica_t* politica, int i, uint64_t tempo);
+
+/// \brief Calcula o instante em que a tarefa i termina, caso no seja interrompida.
+/**
+ *  \param tabela: ponteiro da tabela
+ *  \param i: ndice da tarefa
+ *  \return Instante previsto para o trmino
+ *  \sa tabela_set_inicio(), tabela_checa_termino()
+ */
+uint64_t tabela_previsao_termino(tabela_t* tabela, int i);
+
+/// \brief Calcula o prazo absoluto do "job" pendente mais antigo da tarefa i.
+/**
+ *  \param tabela: ponteiro da tabela
+ *  \param i: ndice da tarefa, com ao menos um "job" pendente
+ *  \return Instante do prazo: chegada do "job" somada ao prazo relativo (D)
+ *  \sa politica_edf
+ */
+uint64_t tabela_prazo(tabela_t* tabela, int i);
+
+/// \brief Escreve as perdas de prazo e os atrasos de cada tarefa.
+/**
+ *  \param fp: arquivo de sada
+ *  \param tabela: ponteiro da tabela, depois da simulao
+ *  \return nmero total de prazos perdidos
+ *  \sa tabela_checa_prazos()
+ */
+uint64_t tabela_imprime_perdas(FILE *fp, tabela_t* tabela);
+
+/// \brief Escreve as estatsticas da simulao em formato de texto separado por ';'.
+/**
+ *  \param fp: arquivo de sada
+ *  \param tabela: ponteiro da tabela, depois da simulao
+ *  \return vazio
+ *  \sa escalonador_simula()
+ *
+ * Uma linha de cabealho, uma linha por tarefa com "jobs" concludos, tempos de resposta mnimo,
+ * mdio e mximo, preempes, variao do incio (latncia mxima - mnima), perdas e maior atraso,
+ * e uma linha "CPU" com a frao ociosa do intervalo simulado. Campos sem valor so "-".
+ * Depois do escalonamento global (nucleos > 1) h tambm a coluna de migraes, e a frao
+ * ociosa  a mdia dos ncleos.
+ */
+void tabela_imprime_estatisticas(FILE *fp, tabela_t* tabela);
+
+/// \brief Funo para depurao do cdigo, onde imprime o estado de todas as tarefas da tabela.
+/**
+ *  \param tabela: ponteiro da tabela
+ *  \return vazio
+ *  \sa imprime_tarefas()
+ */
+void imprime_tabela(tabela_t* tabela);
+
+#endif // TABELA_H_INCLUDED
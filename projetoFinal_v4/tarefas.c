@@ -15,17 +15,16 @@
 #include "tarefas.h"
 
 struct tarefas{            /// Identificador da tarefa
-    uint8_t id;            /// Quanto tempo a tarefa ser totalmente executada - C
+    uint32_t id;           /// Quanto tempo a tarefa ser totalmente executada - C
     uint64_t duracao;      /// Quanto tempo at a tarefa ser executada novamente - T
-    uint64_t periodo;      /// Em que tempo a variavel comeou a ser executada
-    uint32_t tempoInicio;  /// Quantos ciclos a tarefa executou
-    uint32_t tempoExe;     /// Quantos "jobs" esto na fila - Para quando os periodos T se acumulam
-    uint32_t nmrExe;       /// Qual estado da tarefa
+    uint64_t periodo;      /// Prazo relativo  chegada de cada "job" - D
+    uint64_t prazo;        /// Instante da primeira chegada - O
+    uint64_t fase;         /// Qual estado da tarefa
     ESTADO_TAREFA estado;
 };
 
 // Funo cria tarefa
-tarefa_t* cria_tarefa(uint8_t id, uint64_t duracao, uint64_t periodo)
+tarefa_t* cria_tarefa(uint32_t id, uint64_t duracao, uint64_t periodo)
 {
     tarefa_t* p_tarefa;
 
@@ -38,16 +37,32 @@ tarefa_t* cria_tarefa(uint8_t id, uint64_t duracao, uint64_t periodo)
     p_tarefa->id = id;
     p_tarefa->duracao = duracao;
     p_tarefa->periodo = periodo;
+    p_tarefa->prazo = periodo;
+    p_tarefa->fase = 0;
     p_tarefa->estado = PRONTA;
-    p_tarefa->tempoExe = 0;
-    p_tarefa->nmrExe = 0;
 
     return p_tarefa;
 }
 
-uint8_t tarefa_get_id(tarefa_t* tarefa)
+tarefa_t* cria_tarefa_arena(arena_t* arena, uint32_t id, uint64_t duracao, uint64_t periodo)
 {
-    uint8_t id;
+    tarefa_t* p_tarefa;
+
+    p_tarefa = (tarefa_t*) arena_aloca(arena, sizeof(tarefa_t));
+
+    p_tarefa->id = id;
+    p_tarefa->duracao = duracao;
+    p_tarefa->periodo = periodo;
+    p_tarefa->prazo = periodo;
+    p_tarefa->fase = 0;
+    p_tarefa->estado = PRONTA;
+
+    return p_tarefa;
+}
+
+uint32_t tarefa_get_id(tarefa_t* tarefa)
+{
+    uint32_t id;
 
     // Verifica se o ponteiro de tarefa  vlido
     if (tarefa == NULL) {
@@ -89,6 +104,46 @@ uint64_t tarefa_get_periodo(tarefa_t* tarefa)
     return periodo;
 }
 
+uint64_t tarefa_get_prazo(tarefa_t* tarefa)
+{
+    if (tarefa == NULL) {
+        fprintf(stderr, "tarefa_get_prazo: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return tarefa->prazo;
+}
+
+void tarefa_set_prazo(tarefa_t* tarefa, uint64_t prazo)
+{
+    if (tarefa == NULL) {
+        fprintf(stderr, "tarefa_set_prazo: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    tarefa->prazo = prazo;
+}
+
+uint64_t tarefa_get_fase(tarefa_t* tarefa)
+{
+    if (tarefa == NULL) {
+        fprintf(stderr, "tarefa_get_fase: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return tarefa->fase;
+}
+
+void tarefa_set_fase(tarefa_t* tarefa, uint64_t fase)
+{
+    if (tarefa == NULL) {
+        fprintf(stderr, "tarefa_set_fase: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    tarefa->fase = fase;
+}
+
 void tarefa_set_estado(tarefa_t* tarefa, ESTADO_TAREFA estado)
 {
     // Verifica se o ponteiro de tarefa  vlido
@@ -114,29 +169,45 @@ ESTADO_TAREFA tarefa_get_estado(tarefa_t* tarefa)
     return estado;
 }
 
+int tarefa_compara_periodo(void* a, void* b)
+{
+    uint64_t periodo_a = ((tarefa_t*) a)->periodo;
+    uint64_t periodo_b = ((tarefa_t*) b)->periodo;
+
+    return (periodo_a > periodo_b) - (periodo_a < periodo_b);
+}
+
+int tarefa_compara_prazo(void* a, void* b)
+{
+    uint64_t prazo_a = ((tarefa_t*) a)->prazo;
+    uint64_t prazo_b = ((tarefa_t*) b)->prazo;
+
+    return (prazo_a > prazo_b) - (prazo_a < prazo_b);
+}
+
+int tarefa_compara_id(void* a, void* b)
+{
+    uint32_t id_a = ((tarefa_t*) a)->id;
+    uint32_t id_b = ((tarefa_t*) b)->id;
+
+    return (id_a > id_b) - (id_a < id_b);
+}
+
 void ordena_tarefas(lista_enc_t* lista_tarefas)
 {
-    tarefa_t* p_tarefa;
-    tarefa_t* p_tarefa_next;
-    no_t* p_no;
-    int tamanho, i;
+    // Deadline Monotonic: com prazo igual ao perodo  a mesma ordem do Rate Monotonic
+    ordena_tarefas_por(lista_tarefas, tarefa_compara_prazo);
+}
 
-    if (lista_tarefas == NULL) {
+void ordena_tarefas_por(lista_enc_t* lista_tarefas, int (*compara)(void* a, void* b))
+{
+    if (lista_tarefas == NULL || compara == NULL) {
         fprintf(stderr, "ordena_tarefas: Ponteiro invalido\n");
         exit(EXIT_FAILURE);
     }
 
-    for(tamanho = tamanho_lista(lista_tarefas); tamanho>1; tamanho--){
-        p_no = obter_cabeca(lista_tarefas);
-        for(i=0; i<(tamanho-1); i++){
-            p_tarefa = (tarefa_t*) obter_dado(p_no);
-            p_no = obtem_proximo(p_no);
-            p_tarefa_next = (tarefa_t*) obter_dado(p_no);
-            if(tarefa_get_periodo(p_tarefa) > tarefa_get_periodo(p_tarefa_next)){
-                swap_nos(lista_tarefas, obtem_anterior(p_no));
-            }
-        }
-    }
+    // Ordenao estvel: tarefas equivalentes mantm a ordem do arquivo de entrada
+    ordena_lista(lista_tarefas, compara);
 }
 
 void imprime_tarefas(lista_enc_t* listaTarefas)
@@ -162,265 +233,300 @@ void imprime_tarefas(lista_enc_t* listaTarefas)
     while(p_no){
         p_tarefa = (tarefa_t*) obter_dado(p_no);
 
-        printf("Tarefa %d - Estado %s \t", tarefa_get_id(p_tarefa), estados[(int)tarefa_get_estado(p_tarefa)]);
+        printf("Tarefa %" PRIu32 " - Estado %s \t", tarefa_get_id(p_tarefa), estados[(int)tarefa_get_estado(p_tarefa)]);
         periodo = tarefa_get_periodo(p_tarefa);
         duracao = tarefa_get_duracao(p_tarefa);
-        printf("C: %d - T: %d\n", duracao, periodo);
+        printf("C: %d - T: %d - D: %" PRIu64 " - O: %" PRIu64 "\n", duracao, periodo, tarefa_get_prazo(p_tarefa),
+               tarefa_get_fase(p_tarefa));
 
         p_no = obtem_proximo(p_no);
     }
 }
 
-tarefa_t* retorna_tarefa_prio(lista_enc_t* listaTarefas)
+uint64_t calcMDC(uint64_t x, uint64_t y)
 {
-    tarefa_t *p_tarefa;
-    no_t *p_no;
+    uint64_t res;
 
-    if (listaTarefas == NULL) {
-        fprintf(stderr, "retorna_tarefa_prio: Ponteiro invalido\n");
-        exit(EXIT_FAILURE);
-    }
+    do{
+        res = x%y;
 
-    p_no = obter_cabeca(listaTarefas);
+        x = y;
+        y = res;
+    }while(res);
 
-    while(p_no){
-        p_tarefa = (tarefa_t*) obter_dado(p_no);
-        if(tarefa_get_estado(p_tarefa) != OCIOSA){
-            return p_tarefa;
-        }
-        p_no = obtem_proximo(p_no);
+    return x;
+}
+
+uint64_t calcMMC(uint64_t x, uint64_t y)
+{
+    unsigned __int128 mmc;
+
+    if(x == MMC_ESTOURO || y == MMC_ESTOURO){
+        return MMC_ESTOURO;
+    }
+
+    // Divide antes de multiplicar e confere o produto em 128 bits
+    mmc = (unsigned __int128) (x/calcMDC(x,y)) * y;
+    if(mmc > UINT64_MAX){
+        return MMC_ESTOURO;
     }
 
-    return NULL;
+    return (uint64_t) mmc;
 }
 
-void update_tarefas(lista_enc_t* listaTarefas, uint32_t tempo, FILE *fp)
+uint64_t tarefas_calcMMC(lista_enc_t* listaTarefas)
 {
-    no_t* p_no;
     tarefa_t* p_tarefa;
+    no_t* p_no;
+    no_t* p_no_ant;
+    uint64_t mmc;
 
-    // Verifica se o ponteiro de tarefa  vlido
     if (listaTarefas == NULL) {
-        fprintf(stderr, "update_tarefas: Ponteiro invalido\n");
+        fprintf(stderr, "tarefas_calcMMC: Ponteiro invalido\n");
         exit(EXIT_FAILURE);
     }
 
-    p_no = obter_cabeca(listaTarefas);
-
+    p_no_ant = obter_cabeca(listaTarefas);
+    if(p_no_ant == NULL){           // Lista vazia: o MMC de nenhum perodo  1
+        return 1;
+    }
+    p_tarefa = (tarefa_t*) obter_dado(p_no_ant);
+    mmc = p_tarefa->periodo;
+    p_no = obtem_proximo(p_no_ant);
     while(p_no){
         p_tarefa = (tarefa_t*) obter_dado(p_no);
-
-        if(!(tempo%p_tarefa->periodo)){
-            p_tarefa->nmrExe++;
-            // Desenha seta para cima
-            gannt_seta_cima(fp,tarefa_get_id(p_tarefa),tempo);
-            if(p_tarefa->estado == OCIOSA){
-                p_tarefa->estado = PRONTA;
-            }
+        mmc = calcMMC(mmc, p_tarefa->periodo);
+        if(mmc == MMC_ESTOURO){     // No adianta continuar: o MMC s pode crescer
+            break;
         }
+
+        p_no_ant = p_no;
         p_no = obtem_proximo(p_no);
     }
+
+    return mmc;
 }
 
-void tarefa_set_inicio(tarefa_t* tarefa, uint32_t tempo)
+uint64_t tarefas_maior_fase(lista_enc_t* listaTarefas)
 {
-    // Verifica se o ponteiro de tarefa  vlido
-    if (tarefa == NULL) {
-        fprintf(stderr, "tarefa_set_inicio: Ponteiro invalido\n");
+    no_t* p_no;
+    uint64_t maior;
+
+    if (listaTarefas == NULL) {
+        fprintf(stderr, "tarefas_maior_fase: Ponteiro invalido\n");
         exit(EXIT_FAILURE);
     }
 
-    tarefa->tempoInicio = tempo;
-    tarefa->estado = EXECUTANDO;
-}
-
-uint32_t tarefa_get_inicio(tarefa_t* tarefa)
-{
-    // Verifica se o ponteiro de tarefa  vlido
-    if (tarefa == NULL) {
-        fprintf(stderr, "tarefa_get_inicio: Ponteiro invalido\n");
-        exit(EXIT_FAILURE);
+    maior = 0;
+    for(p_no = obter_cabeca(listaTarefas); p_no; p_no = obtem_proximo(p_no)){
+        if(((tarefa_t*) obter_dado(p_no))->fase > maior){
+            maior = ((tarefa_t*) obter_dado(p_no))->fase;
+        }
     }
 
-    return tarefa->tempoInicio;
+    return maior;
 }
 
-void tarefa_set_pausa(tarefa_t* tarefa, uint32_t tempo)
+void gannt_documento(saida_t *saida)
 {
-    // Verifica se o ponteiro de tarefa  vlido
-    if (tarefa == NULL) {
-        fprintf(stderr, "tarefa_set_pausa: Ponteiro invalido\n");
+    if (saida == NULL) {
+        fprintf(stderr, "gannt_documento: Ponteiro invalido\n");
         exit(EXIT_FAILURE);
     }
 
-    tarefa->tempoExe = tarefa->tempoExe + (tempo - tarefa->tempoInicio);
-    tarefa->estado = PARADA;
+    saida_cadeia(saida, "\\documentclass[legalpaper,10pt]{article}\n");
+    saida_cadeia(saida, "\\usepackage[landscape]{geometry}\n");
+    saida_cadeia(saida, "\\usepackage[utf8]{inputenc}\n");
+    saida_cadeia(saida, "\\usepackage[brazil]{babel}\n\n");
+
+    saida_cadeia(saida, "\\usepackage{listings}\n");
+    saida_cadeia(saida, "\\usepackage{listingsutf8}\n\n");
+
+    saida_cadeia(saida, "\\usepackage{rtsched}\n\n");
+
+    saida_cadeia(saida, "\\begin{document}\n\n");
 }
 
-int tarefa_checa_termino(tarefa_t* tarefa, uint32_t tempo)
+void gannt_grade(saida_t *saida, uint32_t numLinhas, uint64_t inicio, uint64_t fim, uint32_t largura)
 {
-    // Verifica se o ponteiro de tarefa  vlido
-    if (tarefa == NULL) {
-        fprintf(stderr, "tarefa_checa_termino: Ponteiro invalido\n");
+    if (saida == NULL) {
+        fprintf(stderr, "gannt_grade: Ponteiro invalido\n");
         exit(EXIT_FAILURE);
     }
 
-    // Necessrio levar em considerao a PAUSA
-    if((tempo-tarefa->tempoInicio)+tarefa->tempoExe == tarefa->duracao){
-        tarefa->nmrExe--;
-        tarefa->tempoExe = 0;
-        if(!tarefa->nmrExe){    // Se a tarefa no tiver mais execues na fila
-            tarefa->estado = OCIOSA;
-        }else tarefa->estado = PRONTA;
-        return 1;
+    saida_cadeia(saida, "\\begin{figure}[h]\n");
+    saida_cadeia(saida, "\\centering\n\n");
+
+    saida_cadeia(saida, "\t% Cria ambiente, ");
+    saida_inteiro(saida, numLinhas);
+    if(inicio){
+        saida_cadeia(saida, " tarefas, escala de tempo de ");
+        saida_inteiro(saida, inicio);
+        saida_cadeia(saida, " at ");
+    }else{
+        saida_cadeia(saida, " tarefas, escala de tempo at ");
     }
-
-    return 0;
+    saida_inteiro(saida, fim);
+    saida_cadeia(saida, "\n\t\\begin{RTGrid}[nosymbols=1,");
+    if(inicio){                         // A grade comea em 0: s a numerao da rgua  deslocada
+        saida_cadeia(saida, "numoffset=");
+        saida_inteiro(saida, inicio);
+        saida_caractere(saida, ',');
+    }
+    saida_cadeia(saida, "width=");
+    if(largura%10 == 0){
+        saida_inteiro(saida, largura/10);
+        saida_cadeia(saida, "cm]{");
+    }else{
+        saida_inteiro(saida, largura);
+        saida_cadeia(saida, "mm]{");
+    }
+    saida_inteiro(saida, numLinhas);
+    saida_cadeia(saida, "}{");
+    saida_inteiro(saida, fim - inicio);
+    saida_cadeia(saida, "}\n\n");
 }
 
-uint64_t calcMDC(uint64_t x, uint64_t y)
+void gannt_finaliza_cabecalho(saida_t *saida)
 {
-    uint64_t res;
-
-    do{
-        res = x%y;
+    if (saida == NULL) {
+        fprintf(stderr, "gannt_finaliza_cabecalho: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
+    }
 
-        x = y;
-        y = res;
-    }while(res);
+    gannt_finaliza_grade(saida);
 
-    return x;
-}
+    saida_cadeia(saida, "\\caption{Exemplo de escalonamento para tarefas.}\n");
+    saida_cadeia(saida, "\\label{fig:ex1}\n");
+    saida_cadeia(saida, "\\end{figure}\n");
 
-uint64_t calcMMC(uint64_t x, uint64_t y)
-{
-    return (x*y)/calcMDC(x,y);
+    gannt_finaliza_documento(saida);
 }
 
-uint64_t tarefas_calcMMC(lista_enc_t* listaTarefas)
+void gannt_finaliza_grade(saida_t *saida)
 {
-    tarefa_t* p_tarefa;
-    no_t* p_no;
-    no_t* p_no_ant;
-    uint64_t mmc;
-
-    if (listaTarefas == NULL) {
-        fprintf(stderr, "tarefas_calcMMC: Ponteiro invalido\n");
+    if (saida == NULL) {
+        fprintf(stderr, "gannt_finaliza_grade: Ponteiro invalido\n");
         exit(EXIT_FAILURE);
     }
 
-    p_no_ant = obter_cabeca(listaTarefas);
-    p_tarefa = (tarefa_t*) obter_dado(p_no_ant);
-    mmc = p_tarefa->periodo;
-    p_no = obtem_proximo(p_no_ant);
-    while(p_no){
-        p_tarefa = (tarefa_t*) obter_dado(p_no);
-        mmc = calcMMC(mmc, p_tarefa->periodo);
-
-        p_no_ant = p_no;
-        p_no = obtem_proximo(p_no);
-    }
-
-    return mmc;
+    saida_cadeia(saida, "\n\t\\end{RTGrid}\n\n");
 }
 
-void gannt_cabecalho(FILE *fp, uint8_t numTarefas, uint32_t escalaTempo)
+void gannt_legenda(saida_t *saida, uint64_t inicio, uint64_t fim, uint64_t figura)
 {
-    if (fp == NULL) {
-        fprintf(stderr, "gannt_cabecalho: Ponteiro invalido\n");
+    if (saida == NULL) {
+        fprintf(stderr, "gannt_legenda: Ponteiro invalido\n");
         exit(EXIT_FAILURE);
     }
 
-    fprintf(fp, "\\documentclass[legalpaper,10pt]{article}\n");
-    fprintf(fp, "\\usepackage[landscape]{geometry}\n");
-    fprintf(fp, "\\usepackage[utf8]{inputenc}\n");
-    fprintf(fp, "\\usepackage[brazil]{babel}\n\n");
-
-    fprintf(fp, "\\usepackage{listings}\n");
-    fprintf(fp, "\\usepackage{listingsutf8}\n\n");
-
-    fprintf(fp, "\\usepackage{rtsched}\n\n");
-
-    fprintf(fp, "\\begin{document}\n\n");
-
-    fprintf(fp, "\\begin{figure}[h]\n");
-    fprintf(fp, "\\centering\n\n");
-
-    fprintf(fp, "\t%% Cria ambiente, %d tarefas, escala de tempo at %d\n", numTarefas+1, escalaTempo);
-    fprintf(fp, "\t\\begin{RTGrid}[nosymbols=1,width=25cm]{%d}{%d}\n\n", numTarefas+1, escalaTempo);
+    saida_cadeia(saida, "\\caption{Escalonamento de $t = ");
+    saida_inteiro(saida, inicio);
+    saida_cadeia(saida, "$ a $t = ");
+    saida_inteiro(saida, fim);
+    saida_cadeia(saida, "$.}\n");
+    saida_cadeia(saida, "\\label{fig:ex");
+    saida_inteiro(saida, figura);
+    saida_cadeia(saida, "}\n");
+    saida_cadeia(saida, "\\end{figure}\n");
 }
 
-void gannt_finaliza_cabecalho(FILE *fp)
+void gannt_finaliza_documento(saida_t *saida)
 {
-    if (fp == NULL) {
-        fprintf(stderr, "gannt_finaliza_cabecalho: Ponteiro invalido\n");
+    if (saida == NULL) {
+        fprintf(stderr, "gannt_finaliza_documento: Ponteiro invalido\n");
         exit(EXIT_FAILURE);
     }
 
-    fprintf(fp, "\n\t\\end{RTGrid}\n\n");
-
-    fprintf(fp, "\\caption{Exemplo de escalonamento para tarefas.}\n");
-    fprintf(fp, "\\label{fig:ex1}\n");
-    fprintf(fp, "\\end{figure}\n");
-    fprintf(fp, "\\end{document}");
+    saida_cadeia(saida, "\\end{document}");
 }
 
-void gannt_nomenclatura(FILE *fp, lista_enc_t* lista_tarefas)
+void gannt_rotulo_cpu(saida_t *saida, uint32_t numTarefas, uint32_t nucleos)
 {
-    tarefa_t* p_tarefa;
-    no_t* p_no;
-    int tamanho, i;
+    uint32_t k;
 
-    if (fp == NULL || lista_tarefas == NULL){
-        fprintf(stderr, "gannt_nomenclatura: Ponteiro invalido\n");
+    if (saida == NULL) {
+        fprintf(stderr, "gannt_rotulo_cpu: Ponteiro invalido\n");
         exit(EXIT_FAILURE);
     }
 
-    fprintf(fp, "\t%% Nomenclatura das tarefas\n");
+    saida_cadeia(saida, "\t% Nomenclatura das tarefas\n");
 
-    tamanho = tamanho_lista(lista_tarefas);
-
-    fprintf(fp, "\t\\RowLabel{%d}{CPU}\n", tamanho+1);
+    if (nucleos <= 1){
+        saida_cadeia(saida, "\t\\RowLabel{");
+        saida_inteiro(saida, (uint64_t) numTarefas+1);
+        saida_cadeia(saida, "}{CPU}\n");
+        return;
+    }
 
-    p_no = obter_cabeca(lista_tarefas);
+    for (k = 1; k <= nucleos; k++){
+        saida_cadeia(saida, "\t\\RowLabel{");
+        saida_inteiro(saida, (uint64_t) numTarefas+k);
+        saida_cadeia(saida, "}{CPU");
+        saida_inteiro(saida, k);
+        saida_cadeia(saida, "}\n");
+    }
+}
 
-    for(i = 0; i < tamanho; i++){
-        p_tarefa = (tarefa_t*) obter_dado(p_no);
-        fprintf(fp, "\t\\RowLabel{%d}{$\\tau_%d$}\n", tarefa_get_id(p_tarefa), tarefa_get_id(p_tarefa));
-        p_no = obtem_proximo(p_no);
+void gannt_rotulo_tarefa(saida_t *saida, uint32_t id)
+{
+    if (saida == NULL) {
+        fprintf(stderr, "gannt_rotulo_tarefa: Ponteiro invalido\n");
+        exit(EXIT_FAILURE);
     }
 
-    fprintf(fp, "\n");
+    saida_cadeia(saida, "\t\\RowLabel{");
+    saida_inteiro(saida, id);
+    saida_cadeia(saida, "}{$\\tau_");
+    saida_inteiro(saida, id);
+    saida_cadeia(saida, "$}\n");
 }
 
-void gannt_seta_cima(FILE *fp, uint8_t id, uint32_t tempo)
+// Linhas de evento: "\t\<comando>{id}{t1}" ou "\t\<comando>{id}{t1}{t2}", montadas sem printf
+#define TEXTO(s)    s, sizeof(s) - 1
+
+void gannt_seta_cima(saida_t *saida, uint32_t id, uint64_t tempo)
 {
-    if (fp == NULL) {
+    if (saida == NULL) {
         fprintf(stderr, "gannt_seta_cima: Ponteiro invalido\n");
         exit(EXIT_FAILURE);
     }
 
-    fprintf(fp, "\t\\TaskArrival{%d}{%d}\n", id, tempo);
+    saida_texto(saida, TEXTO("\t\\TaskArrival{"));
+    saida_inteiro(saida, id);
+    saida_texto(saida, TEXTO("}{"));
+    saida_inteiro(saida, tempo);
+    saida_texto(saida, TEXTO("}\n"));
 }
 
-void gannt_seta_baixo(FILE *fp, uint8_t id, uint32_t tempo)
+void gannt_seta_baixo(saida_t *saida, uint32_t id, uint64_t tempo)
 {
-    if (fp == NULL) {
+    if (saida == NULL) {
         fprintf(stderr, "gannt_seta_baixo: Ponteiro invalido\n");
         exit(EXIT_FAILURE);
     }
 
-    fprintf(fp, "\t\\TaskDeadline{%d}{%d}\n", id, tempo);
+    saida_texto(saida, TEXTO("\t\\TaskDeadline{"));
+    saida_inteiro(saida, id);
+    saida_texto(saida, TEXTO("}{"));
+    saida_inteiro(saida, tempo);
+    saida_texto(saida, TEXTO("}\n"));
 }
 
-void gannt_quadrado(FILE *fp, uint8_t id, uint32_t inicio, uint32_t fim)
+void gannt_quadrado(saida_t *saida, uint32_t id, uint64_t inicio, uint64_t fim)
 {
-    if (fp == NULL) {
+    if (saida == NULL) {
         fprintf(stderr, "gannt_quadrado: Ponteiro invalido\n");
         exit(EXIT_FAILURE);
     }
 
-    fprintf(fp, "\t\\TaskExecution{%d}{%d}{%d}\n", id, inicio, fim);
+    saida_texto(saida, TEXTO("\t\\TaskExecution{"));
+    saida_inteiro(saida, id);
+    saida_texto(saida, TEXTO("}{"));
+    saida_inteiro(saida, inicio);
+    saida_texto(saida, TEXTO("}{"));
+    saida_inteiro(saida, fim);
+    saida_texto(saida, TEXTO("}\n"));
 }
 
 void desaloca_lista_tarefas(lista_enc_t* lista_tarefas)
@@ -433,6 +539,10 @@ void desaloca_lista_tarefas(lista_enc_t* lista_tarefas)
         exit(EXIT_FAILURE);
     }
 
+    if(lista_obter_arena(lista_tarefas) != NULL){   // Tudo pertence  arena
+        return;
+    }
+
     while(!lista_vazia(lista_tarefas)){
         p_no = remover_cabeca(lista_tarefas);
         p_tarefa = (tarefa_t*) obter_dado(p_no);
@@ -13,6 +13,10 @@
 
 #include <inttypes.h>
 #include "lista_enc.h"
+#include "saida.h"
+
+#define MMC_ESTOURO     0   ///< Retorno das funes de MMC quando o resultado no cabe em 64 bits
+#define GANNT_LARGURA   250 ///< Largura do Diagrama de Gannt, em mm
 
 /** \enum ESTADO_TAREFA
  * Indica qual  o estado da tarefa, sendo:
@@ -27,11 +31,13 @@ typedef enum{
 /** \struct tarefas tarefas.h "tarefas.h"
  *   \brief Estrutura das tarefas
  *
- * Todas as tarefas contm um identificador (id), durao (C), perodo (T), tempo de incio, tempo executado,
+ * Todas as tarefas contm um identificador (id), durao (C), perodo (T), prazo (D), fase (O), tempo de incio, tempo executado,
  * numero de "jobs" que esto na fila e estado. O tempo no decorrer do programa  medido em "ticks".
  * A durao (C) corresponde quanto tempo a tarefa precisa para ser executada por completo.
  * Quanto menor o perodo (T) de uma tarefa, maior ser sua prioridade na fila de tarefas, sendo que esse
  * nmero significa de quanto em quanto tempo a tarefa ser chamada.
+ * O prazo (D)  contado a partir de cada chegada e vale T, a menos que seja indicado com tarefa_set_prazo().
+ * A fase (O)  o instante da primeira chegada; as seguintes ocorrem em O + kT.
  * O tempo de incio  o tempo no qual a tarefa comeou a ser executada.
  * O tempo de execuo representa quantos ciclos a tarefa executou.
  * O nmero de execuo representa quantos "jobs" esto na fila.
@@ -47,7 +53,18 @@ typedef struct tarefas tarefa_t;
  *  \return Um ponteiro alocado do tipo tarefa_t
  *  \sa tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_set_estado(), tarefa_get_estado()
  */
-tarefa_t* cria_tarefa(uint8_t id, uint64_t duracao, uint64_t periodo);
+tarefa_t* cria_tarefa(uint32_t id, uint64_t duracao, uint64_t periodo);
+
+/// \brief Criao de tarefas em uma arena, indicando C e T
+/**
+ *  \param arena: arena onde a tarefa  alocada
+ *  \param id: Identificador para a tarefa
+ *  \param duracao: Tempo de durao da tarefa - C
+ *  \param periodo: Tempo para chamada da tarefa - T
+ *  \return Um ponteiro do tipo tarefa_t, liberado junto com a arena
+ *  \sa cria_tarefa(), cria_lista_enc_arena(), cria_no_arena()
+ */
+tarefa_t* cria_tarefa_arena(arena_t* arena, uint32_t id, uint64_t duracao, uint64_t periodo);
 
 /// \brief Adquire o id da tarefa
 /**
@@ -55,7 +72,7 @@ tarefa_t* cria_tarefa(uint8_t id, uint64_t duracao, uint64_t periodo);
  *  \return id: identificador da tarefa
  *  \sa cria_tarefa(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_set_estado(), tarefa_get_estado()
  */
-uint8_t tarefa_get_id(tarefa_t* tarefa);
+uint32_t tarefa_get_id(tarefa_t* tarefa);
 
 /// \brief Adquire a durao (C) da tarefa
 /**
@@ -73,100 +90,113 @@ uint64_t tarefa_get_duracao(tarefa_t* tarefa);
  */
 uint64_t tarefa_get_periodo(tarefa_t* tarefa);
 
-/// \brief Estabelece o estado da tarefa
+/// \brief Adquire o prazo relativo (D) da tarefa
 /**
  *  \param tarefa: um ponteiro que representa o endereo da tarefa
- *  \param estado: pondendo ser OCIOSO, EXECUTANDO, PRONTA ou PARADA
- *  \return vazio
- *  \sa cria_tarefa(), tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_get_estado()
+ *  \return Prazo da tarefa, igual ao perodo caso no tenha sido estabelecido
+ *  \sa tarefa_set_prazo(), tarefa_get_periodo()
  */
-void tarefa_set_estado(tarefa_t* tarefa, ESTADO_TAREFA estado);
+uint64_t tarefa_get_prazo(tarefa_t* tarefa);
 
-/// \brief Adquire o estado da tarefa
+/// \brief Estabelece o prazo relativo (D) da tarefa
 /**
  *  \param tarefa: um ponteiro que representa o endereo da tarefa
- *  \return estado: pondendo ser OCIOSO, EXECUTANDO, PRONTA ou PARADA
- *  \sa cria_tarefa(), tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_set_estado()
+ *  \param prazo: prazo contado a partir de cada chegada, entre 1 e o perodo
+ *  \return vazio
+ *  \sa tarefa_get_prazo()
  */
-ESTADO_TAREFA tarefa_get_estado(tarefa_t* tarefa);
+void tarefa_set_prazo(tarefa_t* tarefa, uint64_t prazo);
 
-/// \brief Ordena as tarefas pelo perodo (T), sendo do menor para o maior.
+/// \brief Adquire a fase (O) da tarefa
 /**
- *  \param lista_tarefas: um ponteiro que representa o endereo da lista de tarefas
- *  \return vazio
- *  \sa cria_tarefa(), tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_set_estado()
+ *  \param tarefa: um ponteiro que representa o endereo da tarefa
+ *  \return Instante da primeira chegada, 0 caso no tenha sido estabelecido
+ *  \sa tarefa_set_fase(), tarefas_maior_fase()
  */
-void ordena_tarefas(lista_enc_t* lista_tarefas);
+uint64_t tarefa_get_fase(tarefa_t* tarefa);
 
-// Funo para testes:
-/// \brief Funo para depurao do cdigo, onde imprime todas as informaes de todas tarefas da lista.
+/// \brief Estabelece a fase (O) da tarefa
 /**
- *  \param listaTarefas: um ponteiro que representa o endereo da lista de tarefas
+ *  \param tarefa: um ponteiro que representa o endereo da tarefa
+ *  \param fase: instante da primeira chegada
  *  \return vazio
- *  \sa cria_tarefa(), tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_set_estado()
+ *  \sa tarefa_get_fase()
  */
-void imprime_tarefas(lista_enc_t* listaTarefas);
+void tarefa_set_fase(tarefa_t* tarefa, uint64_t fase);
 
-/// \brief Estabelece o tempo de incio da tarefa.
+/// \brief Estabelece o estado da tarefa
 /**
  *  \param tarefa: um ponteiro que representa o endereo da tarefa
- *  \param tempo: um ponteiro que representa o endereo da tarefa
+ *  \param estado: pondendo ser OCIOSO, EXECUTANDO, PRONTA ou PARADA
  *  \return vazio
+ *  \sa cria_tarefa(), tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_get_estado()
  */
-void tarefa_set_inicio(tarefa_t* tarefa, uint32_t tempo);
+void tarefa_set_estado(tarefa_t* tarefa, ESTADO_TAREFA estado);
 
-/// \brief Adquire o tempo de incio da tarefa.
+/// \brief Adquire o estado da tarefa
 /**
  *  \param tarefa: um ponteiro que representa o endereo da tarefa
- *  \return Tempo de incio da tarefa
+ *  \return estado: pondendo ser OCIOSO, EXECUTANDO, PRONTA ou PARADA
  *  \sa cria_tarefa(), tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_set_estado()
  */
-uint32_t tarefa_get_inicio(tarefa_t* tarefa);
+ESTADO_TAREFA tarefa_get_estado(tarefa_t* tarefa);
 
-/// \brief Adquire a tarefa prioritria.
+/// \brief Ordena as tarefas pelo prazo (D), sendo do menor para o maior (Deadline Monotonic).
 /**
- *  \param listaTarefas: um ponteiro que representa o endereo da lista de tarefas
- *  \return Tarefa prioritria
- *  \sa cria_tarefa(), tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_set_estado()
+ *  \param lista_tarefas: um ponteiro que representa o endereo da lista de tarefas
+ *  \return vazio
+ *  \sa tarefa_compara_prazo(), ordena_tarefas_por()
+ *
+ * Com prazo igual ao perodo a ordem  a do Rate Monotonic.
  */
-tarefa_t* retorna_tarefa_prio(lista_enc_t* listaTarefas);
+void ordena_tarefas(lista_enc_t* lista_tarefas);
 
-/// \brief Verifica requisio de tarefa.
+/// \brief Ordena as tarefas de acordo com uma funo de comparao.
 /**
- *  \param listaTarefas: um ponteiro que representa o endereo da lista de tarefas
- *  \param tempo: tempo
- *  \param fp: um ponteiro que representa o endereo da lista de tarefas
- *  \return Vazio
- *  \sa cria_tarefa(), tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_set_estado()
+ *  \param lista_tarefas: um ponteiro que representa o endereo da lista de tarefas
+ *  \param compara: funo que recebe duas tarefas e retorna < 0, 0 ou > 0
+ *  \return vazio
+ *  \sa ordena_tarefas(), tarefa_compara_periodo(), tarefa_compara_id()
+ *
+ * A ordenao  estvel, O(n log n), e religa os ns da prpria lista.
  */
-void update_tarefas(lista_enc_t* listaTarefas, uint32_t tempo, FILE *fp);
+void ordena_tarefas_por(lista_enc_t* lista_tarefas, int (*compara)(void* a, void* b));
 
-/// \brief Estabelece o tempo de incio da tarefa.
+/// \brief Compara duas tarefas pelo perodo (T) - prioridade Rate Monotonic.
 /**
- *  \param tarefa: um ponteiro que representa o endereo da tarefa
- *  \param tempo: tempo de incio que ser estabelecido
- *  \return Vazio
- *  \sa cria_tarefa(), tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_set_estado()
+ *  \param a: ponteiro da primeira tarefa
+ *  \param b: ponteiro da segunda tarefa
+ *  \return < 0 se a tem menor perodo, 0 se iguais, > 0 se a tem maior perodo
+ *  \sa ordena_tarefas_por()
  */
-void tarefa_set_inicio(tarefa_t* tarefa, uint32_t tempo);
+int tarefa_compara_periodo(void* a, void* b);
 
-/// \brief Estabelece o tempo de pausa da tarefa.
+/// \brief Compara duas tarefas pelo prazo (D) - prioridade Deadline Monotonic.
 /**
- *  \param tarefa: um ponteiro que representa o endereo da tarefa
- *  \param tempo: tempo de pausa que ser estabelecido
- *  \return Vazio
- *  \sa cria_tarefa(), tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_set_estado()
+ *  \param a: ponteiro da primeira tarefa
+ *  \param b: ponteiro da segunda tarefa
+ *  \return < 0 se a tem menor prazo, 0 se iguais, > 0 se a tem maior prazo
+ *  \sa ordena_tarefas_por()
  */
-void tarefa_set_pausa(tarefa_t* tarefa, uint32_t tempo);
+int tarefa_compara_prazo(void* a, void* b);
 
-/// \brief Verifica se a tarefa est terminada.
+/// \brief Compara duas tarefas pelo identificador - prioridade explcita dada pelo id.
 /**
- *  \param tarefa: um ponteiro que representa o endereo da tarefa
- *  \param tempo: tempo que ser verificado.
- *  \return 0: tarefa no terminada; 1: tarefa terminada
+ *  \param a: ponteiro da primeira tarefa
+ *  \param b: ponteiro da segunda tarefa
+ *  \return < 0 se a tem menor id, 0 se iguais, > 0 se a tem maior id
+ *  \sa ordena_tarefas_por()
+ */
+int tarefa_compara_id(void* a, void* b);
+
+// Funo para testes:
+/// \brief Funo para depurao do cdigo, onde imprime todas as informaes de todas tarefas da lista.
+/**
+ *  \param listaTarefas: um ponteiro que representa o endereo da lista de tarefas
+ *  \return vazio
  *  \sa cria_tarefa(), tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_set_estado()
  */
-int tarefa_checa_termino(tarefa_t* tarefa, uint32_t tempo);
+void imprime_tarefas(lista_enc_t* listaTarefas);
 
 /// \brief Calcula o mximo divisor comum (MDC) entre dois nmeros.
 /**
@@ -181,7 +211,7 @@ uint64_t calcMDC(uint64_t x, uint64_t y);
 /**
  *  \param x: nmero inteiro no sinalizado
  *  \param y: nmero inteiro no sinalizado
- *  \return mnimo mltiplo comum
+ *  \return mnimo mltiplo comum, ou MMC_ESTOURO caso no caiba em 64 bits
  *  \sa cria_tarefa(), tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_set_estado()
  */
 uint64_t calcMMC(uint64_t x, uint64_t y);
@@ -189,68 +219,132 @@ uint64_t calcMMC(uint64_t x, uint64_t y);
 /// \brief Calcula o mnimo mltiplo comum (MMC) do perodo (T) de uma lista de tarefas.
 /**
  *  \param listaTarefas: ponteiro que representa o endereo de uma lista de tarefas
- *  \return mnimo mltiplo comum dos perodos (T) da lista de tarefas
+ *  \return mnimo mltiplo comum dos perodos (T) da lista de tarefas, 1 se ela estiver vazia, ou MMC_ESTOURO
  *  \sa cria_tarefa(), tarefa_get_id(), tarefa_get_duracao(), tarefa_get_periodo(), tarefa_set_estado()
+ *
+ * O clculo  interrompido no primeiro estouro, para que o chamador decida antes de simular
+ * se usa a anlise ou uma janela de simulao limitada.
  */
 uint64_t tarefas_calcMMC(lista_enc_t* listaTarefas);
 
-/// \brief Escreve em um arquivo de sada o cabealho do Diagrama de Gannt.
+/// \brief Calcula a maior fase (O) de uma lista de tarefas.
 /**
- *  \param fp: ponteiro do arquivo de sada
- *  \param numTarefas: numero de tarefas do Diagrama de Gannt
- *  \param escalaTempo: escala de tempo do Diagrama de Gannt
+ *  \param listaTarefas: ponteiro que representa o endereo de uma lista de tarefas
+ *  \return maior fase, 0 caso todas as tarefas cheguem juntas no instante 0
+ *  \sa tarefa_get_fase(), tarefas_calcMMC()
+ *
+ * Com fases o escalonamento s se repete depois de todas as tarefas chegarem, e o intervalo que
+ * precisa ser simulado passa a ser [0, maior fase + 2*hiperperodo].
+ */
+uint64_t tarefas_maior_fase(lista_enc_t* listaTarefas);
+
+/// \brief Escreve em um arquivo de sada o prembulo do documento .tex, at o \\begin{document}.
+/**
+ *  \param saida: sada bufferizada do arquivo .tex
  *  \return vazio
- *  \sa gannt_finaliza_cabecalho(), gannt_nomenclatura(), gannt_seta_cima(), gannt_seta_baixo(), gannt_quadrado()
+ *  \sa gannt_grade(), gannt_finaliza_documento()
  */
-void gannt_cabecalho(FILE *fp, uint8_t numTarefas, uint32_t escalaTempo);
+void gannt_documento(saida_t *saida);
+
+/// \brief Escreve em um arquivo de sada o incio de uma figura com o RTGrid do intervalo [inicio, fim].
+/**
+ *  \param saida: sada bufferizada do arquivo .tex
+ *  \param numLinhas: numero de linhas da grade, tarefas mais CPUs
+ *  \param inicio: instante do incio da grade
+ *  \param fim: instante do fim da grade
+ *  \param largura: largura da grade em mm
+ *  \return vazio
+ *  \sa gannt_documento(), gannt_finaliza_grade(), gannt_legenda()
+ *
+ * A grade do rtsched sempre comea em 0: com inicio > 0 os eventos devem ser escritos em relao a
+ * inicio, e somente a numerao da rgua  deslocada (numoffset).
+ */
+void gannt_grade(saida_t *saida, uint32_t numLinhas, uint64_t inicio, uint64_t fim, uint32_t largura);
+
+/// \brief Escreve em um arquivo de sada o fim do RTGrid aberto por gannt_grade().
+/**
+ *  \param saida: sada bufferizada do arquivo .tex
+ *  \return vazio
+ *  \sa gannt_grade(), gannt_legenda()
+ */
+void gannt_finaliza_grade(saida_t *saida);
+
+/// \brief Escreve em um arquivo de sada a legenda do intervalo [inicio, fim] e o fim da figura.
+/**
+ *  \param saida: sada bufferizada do arquivo .tex
+ *  \param inicio: instante do incio da grade
+ *  \param fim: instante do fim da grade
+ *  \param figura: nmero da figura, usado no rtulo fig:ex<figura>
+ *  \return vazio
+ *  \sa gannt_grade(), gannt_finaliza_grade()
+ */
+void gannt_legenda(saida_t *saida, uint64_t inicio, uint64_t fim, uint64_t figura);
+
+/// \brief Escreve em um arquivo de sada o fim do documento .tex.
+/**
+ *  \param saida: sada bufferizada do arquivo .tex
+ *  \return vazio
+ *  \sa gannt_documento(), gannt_finaliza_cabecalho()
+ */
+void gannt_finaliza_documento(saida_t *saida);
 
 /// \brief Escreve em um arquivo de sada a finalizao do cabealho do Diagrama de Gannt.
 /**
- *  \param fp: ponteiro do arquivo de sada
+ *  \param saida: sada bufferizada do arquivo .tex
  *  \return vazio
- *  \sa gannt_cabecalho(), gannt_nomenclatura(), gannt_seta_cima(), gannt_seta_baixo(), gannt_quadrado()
+ *  \sa gannt_finaliza_grade(), gannt_finaliza_documento()
  */
-void gannt_finaliza_cabecalho(FILE *fp);
+void gannt_finaliza_cabecalho(saida_t *saida);
 
-/// \brief Escreve em um arquivo de sada a legenda das tarefas no Diagrama de Gannt.
+/// \brief Escreve em um arquivo de sada o incio da legenda e os rtulos das linhas das CPUs.
 /**
- *  \param fp: ponteiro do arquivo de sada
- *  \param lista_tarefas: ponteiro que representa o endereo de uma lista de tarefas
+ *  \param saida: sada bufferizada do arquivo .tex
+ *  \param numTarefas: numero de tarefas do Diagrama de Gannt, as CPUs ficam nas linhas seguintes
+ *  \param nucleos: numero de ncleos; com um s a linha  CPU, com mais so CPU1, CPU2...
+ *  \return vazio
+ *  \sa gannt_rotulo_tarefa()
+ */
+void gannt_rotulo_cpu(saida_t *saida, uint32_t numTarefas, uint32_t nucleos);
+
+/// \brief Escreve em um arquivo de sada o rtulo da linha de uma tarefa.
+/**
+ *  \param saida: sada bufferizada do arquivo .tex
+ *  \param id: identificador da tarefa
  *  \return vazio
- *  \sa gannt_cabecalho(), gannt_finaliza_cabecalho(), gannt_seta_cima(), gannt_seta_baixo(), gannt_quadrado()
+ *  \sa gannt_rotulo_cpu()
  */
-void gannt_nomenclatura(FILE *fp, lista_enc_t* lista_tarefas);
+void gannt_rotulo_tarefa(saida_t *saida, uint32_t id);
 
 /// \brief Escreve em um arquivo de sada a chegada de uma tarefa no Diagrama de Gannt.
 /**
- *  \param fp: ponteiro do arquivo de sada
+ *  \param saida: sada bufferizada do arquivo .tex
  *  \param id: identificador da tarefa
  *  \param tempo: tempo de chegada da tarefa
  *  \return vazio
- *  \sa gannt_cabecalho(), gannt_finaliza_cabecalho(), gannt_nomenclatura(), gannt_seta_baixo(), gannt_quadrado()
+ *  \sa gannt_grade(), gannt_seta_baixo(), gannt_quadrado()
  */
-void gannt_seta_cima(FILE *fp, uint8_t id, uint32_t tempo);
+void gannt_seta_cima(saida_t *saida, uint32_t id, uint64_t tempo);
 
 /// \brief Escreve em um arquivo de sada o trmino de uma tarefa no Diagrama de Gannt.
 /**
- *  \param fp: ponteiro do arquivo de sada
+ *  \param saida: sada bufferizada do arquivo .tex
  *  \param id: identificador da tarefa
  *  \param tempo: tempo de trmino da tarefa
  *  \return vazio
- *  \sa gannt_cabecalho(), gannt_finaliza_cabecalho(), gannt_nomenclatura(), gannt_seta_cima(), gannt_quadrado()
+ *  \sa gannt_grade(), gannt_seta_cima(), gannt_quadrado()
  */
-void gannt_seta_baixo(FILE *fp, uint8_t id, uint32_t tempo);
+void gannt_seta_baixo(saida_t *saida, uint32_t id, uint64_t tempo);
 
 /// \brief Escreve em um arquivo de sada a execuo de uma tarefa no Diagrama de Gannt.
 /**
- *  \param fp: ponteiro do arquivo de sada
+ *  \param saida: sada bufferizada do arquivo .tex
  *  \param id: identificador da tarefa
  *  \param inicio: tempo de incio da execuo
  *  \param fim: tempo de fim da execuo
  *  \return vazio
- *  \sa gannt_cabecalho(), gannt_finaliza_cabecalho(), gannt_nomenclatura(), gannt_seta_cima(), gannt_seta_baixo()
+ *  \sa gannt_grade(), gannt_seta_cima(), gannt_seta_baixo()
  */
-void gannt_quadrado(FILE *fp, uint8_t id, uint32_t inicio, uint32_t fim);
+void gannt_quadrado(saida_t *saida, uint32_t id, uint64_t inicio, uint64_t fim);
 
 /// \brief Desaloca o espao de memria utilizado pela lista de tarefas.
 /**
@@ -259,6 +353,7 @@ void gannt_quadrado(FILE *fp, uint8_t id, uint32_t inicio, uint32_t fim);
  *  \sa cria_no(), cria_lista_enc(), cria_tarefa()
  *
  * Funo recebe toda a lista e desaloca ns, tarefas e a lista.
+ * Listas criadas em uma arena no so desalocadas aqui, mas pelo reincio ou desalocao da arena.
  */
 void desaloca_lista_tarefas(lista_enc_t* lista_tarefas);
 
@@ -0,0 +1,312 @@
+/** \file traco.c
+ * \brief   Trao binrio da simulao: gravao e leitura mapeada em memria (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "traco.h"
+#include "tabela.h"
+#include "saida.h"
+
+struct gravadores {
+    saida_t *saida;
+};
+
+struct tracos {
+    void *mapa;                 // Arquivo inteiro
+    size_t tamanho;
+    const traco_cabecalho_t *cabecalho;
+    const traco_tarefa_t *tarefas;
+    const evento_t *eventos;
+    size_t numEventos;          // Sem o EVENTO_FIM
+};
+
+gravador_t *cria_gravador(const char *arquivo, struct tabela *tabela, uint64_t horizonte)
+{
+    traco_cabecalho_t cabecalho;
+    traco_tarefa_t tarefa;
+    gravador_t *p;
+    saida_t *saida;
+    int i;
+
+    if (arquivo == NULL || tabela == NULL){
+        fprintf(stderr,"cria_gravador: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    saida = cria_saida(arquivo);
+    if (saida == NULL)
+        return NULL;
+
+    p = malloc(sizeof(gravador_t));
+    if (p == NULL){
+        perror("cria_gravador:");
+        exit(EXIT_FAILURE);
+    }
+    p->saida = saida;
+
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magica, TRACO_MAGICA, sizeof(TRACO_MAGICA));
+    cabecalho.versao = TRACO_VERSAO;
+    cabecalho.ordem = TRACO_ORDEM;
+    cabecalho.numTarefas = tabela->n;
+    cabecalho.tamanhoEvento = sizeof(evento_t);
+    cabecalho.horizonte = horizonte;
+    saida_texto(saida, (const char*) &cabecalho, sizeof(cabecalho));
+
+    for (i = 0; i < tabela->n; i++){
+        tarefa.id = tabela->id[i];
+        tarefa.reservado = 0;
+        tarefa.duracao = tabela->duracao[i];
+        tarefa.periodo = tabela->periodo[i];
+        tarefa.prazo = tabela->prazo[i];
+        tarefa.fase = tabela->fase[i];
+        saida_texto(saida, (const char*) &tarefa, sizeof(tarefa));
+    }
+
+    return p;
+}
+
+void gravador_evento(gravador_t *gravador, const evento_t *evento)
+{
+    if (gravador == NULL || evento == NULL){
+        fprintf(stderr,"gravador_evento: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    saida_texto(gravador->saida, (const char*) evento, sizeof(evento_t));
+}
+
+int fecha_gravador(gravador_t *gravador, uint64_t fim)
+{
+    evento_t evento = {fim, fim, 0, EVENTO_FIM};
+    int retorno;
+
+    if (gravador == NULL){
+        fprintf(stderr,"fecha_gravador: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    saida_texto(gravador->saida, (const char*) &evento, sizeof(evento));
+    retorno = fecha_saida(gravador->saida);
+    free(gravador);
+
+    return retorno;
+}
+
+// Mapeia o arquivo inteiro em memria - no Windows o arquivo  lido de uma vez
+static void *mapeia(const char *nome, size_t *tamanho)
+{
+    void *mapa;
+#ifdef _WIN32
+    FILE *fp;
+    long t;
+
+    fp = fopen(nome, "rb");
+    if (fp == NULL)
+        return NULL;
+
+    fseek(fp, 0, SEEK_END);
+    t = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    mapa = malloc(t > 0 ? t : 1);
+    if (mapa == NULL || fread(mapa, 1, t, fp) != (size_t) t){
+        free(mapa);
+        fclose(fp);
+        return NULL;
+    }
+    fclose(fp);
+    *tamanho = t;
+#else
+    struct stat info;
+    int fd;
+
+    fd = open(nome, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    if (fstat(fd, &info) < 0 || info.st_size == 0){
+        close(fd);
+        return NULL;
+    }
+
+    *tamanho = info.st_size;
+    mapa = mmap(NULL, *tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED)
+        return NULL;
+#endif
+
+    return mapa;
+}
+
+static void desmapeia(void *mapa, size_t tamanho)
+{
+#ifdef _WIN32
+    (void) tamanho;
+    free(mapa);
+#else
+    munmap(mapa, tamanho);
+#endif
+}
+
+traco_t *abre_traco(const char *arquivo)
+{
+    const traco_cabecalho_t *cabecalho;
+    const evento_t *ultimo;
+    traco_t *p;
+    size_t inicioEventos, numRegistros;
+    size_t tamanho = 0;
+    void *mapa;
+
+    if (arquivo == NULL){
+        fprintf(stderr,"abre_traco: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    mapa = mapeia(arquivo, &tamanho);
+    if (mapa == NULL){
+        perror(arquivo);
+        return NULL;
+    }
+
+    cabecalho = mapa;
+    if (tamanho < sizeof(traco_cabecalho_t) || memcmp(cabecalho->magica, TRACO_MAGICA, sizeof(TRACO_MAGICA)) != 0){
+        fprintf(stderr, "%s: nao e um arquivo de traco\n", arquivo);
+        desmapeia(mapa, tamanho);
+        return NULL;
+    }
+    if (cabecalho->ordem != TRACO_ORDEM || cabecalho->versao != TRACO_VERSAO
+        || cabecalho->tamanhoEvento != sizeof(evento_t)){
+        fprintf(stderr, "%s: traco de outra versao ou arquitetura\n", arquivo);
+        desmapeia(mapa, tamanho);
+        return NULL;
+    }
+
+    // Os eventos comeam logo aps a tabela; o arquivo termina em um EVENTO_FIM
+    inicioEventos = sizeof(traco_cabecalho_t) + (size_t) cabecalho->numTarefas*sizeof(traco_tarefa_t);
+    numRegistros = tamanho > inicioEventos ? (tamanho - inicioEventos)/sizeof(evento_t) : 0;
+    ultimo = numRegistros ? (const evento_t*) ((const char*) mapa + inicioEventos) + numRegistros - 1 : NULL;
+    if (ultimo == NULL || inicioEventos + numRegistros*sizeof(evento_t) != tamanho || ultimo->tipo != EVENTO_FIM){
+        fprintf(stderr, "%s: traco incompleto\n", arquivo);
+        desmapeia(mapa, tamanho);
+        return NULL;
+    }
+
+    p = malloc(sizeof(traco_t));
+    if (p == NULL){
+        perror("abre_traco:");
+        exit(EXIT_FAILURE);
+    }
+
+    p->mapa = mapa;
+    p->tamanho = tamanho;
+    p->cabecalho = cabecalho;
+    p->tarefas = (const traco_tarefa_t*) (cabecalho + 1);
+    p->eventos = (const evento_t*) ((const char*) mapa + inicioEventos);
+    p->numEventos = numRegistros - 1;
+
+    return p;
+}
+
+void fecha_traco(traco_t *traco)
+{
+    if (traco == NULL){
+        fprintf(stderr,"fecha_traco: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    desmapeia(traco->mapa, traco->tamanho);
+    free(traco);
+}
+
+const traco_cabecalho_t *traco_cabecalho(traco_t *traco)
+{
+    if (traco == NULL){
+        fprintf(stderr,"traco_cabecalho: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    return traco->cabecalho;
+}
+
+const traco_tarefa_t *traco_tarefas(traco_t *traco)
+{
+    if (traco == NULL){
+        fprintf(stderr,"traco_tarefas: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    return traco->tarefas;
+}
+
+const evento_t *traco_eventos(traco_t *traco)
+{
+    if (traco == NULL){
+        fprintf(stderr,"traco_eventos: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    return traco->eventos;
+}
+
+size_t traco_num_eventos(traco_t *traco)
+{
+    if (traco == NULL){
+        fprintf(stderr,"traco_num_eventos: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    return traco->numEventos;
+}
+
+uint64_t traco_fim(traco_t *traco)
+{
+    if (traco == NULL){
+        fprintf(stderr,"traco_fim: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    return traco->eventos[traco->numEventos].inicio;
+}
+
+size_t traco_busca(traco_t *traco, uint64_t tempo)
+{
+    size_t inicio, fim, meio;
+
+    if (traco == NULL){
+        fprintf(stderr,"traco_busca: ponteiro invalido");
+        exit(EXIT_FAILURE);
+    }
+
+    // Primeiro ndice em [inicio, fim) cuja chave no  menor que tempo
+    inicio = 0;
+    fim = traco->numEventos;
+    while (inicio < fim){
+        meio = inicio + (fim - inicio)/2;
+        if (traco_chave(&traco->eventos[meio]) < tempo)
+            inicio = meio + 1;
+        else
+            fim = meio;
+    }
+
+    return inicio;
+}
@@ -0,0 +1,95 @@
+/** \file traco.h
+ * \brief   Cabealho do trao binrio da simulao: gravao e leitura mapeada em memria (TaD).
+ *
+ * \author  Srgio Luiz Martins Jr.
+ * \author  Marcos Vincius Leal da Silva
+ * \date    17/10/26
+ * \version 1.0
+ *
+ * O trao guarda os eventos da simulao sem formatao, para que o Diagrama de Gannt, o CSV e
+ * outras sadas sejam gerados depois sem simular de novo. O arquivo tem um cabealho fixo
+ * (traco_cabecalho_t), a tabela de tarefas (traco_tarefa_t, na ordem de prioridade) e os eventos
+ * (evento_t, 24 bytes cada), terminados por um EVENTO_FIM com o ltimo instante simulado.
+ * Os inteiros ficam na ordem de bytes da mquina que gravou; o campo ordem permite recusar um
+ * trao de outra arquitetura.
+ *
+ * Os eventos esto em ordem no decrescente de traco_chave(): o instante do evento, ou o fim do
+ * trecho no caso de execues, que  quando o simulador os conhece. Isso permite a busca binria
+ * por tempo diretamente no arquivo mapeado.
+ */
+
+#ifndef TRACO_H_INCLUDED
+#define TRACO_H_INCLUDED
+
+#include <stddef.h>
+#include <inttypes.h>
+
+#include "anel.h"
+
+struct tabela;
+
+#define TRACO_MAGICA    "TRACORM"   // 7 caracteres e o '\0'
+#define TRACO_VERSAO    1
+#define TRACO_ORDEM     0x01020304u // Lido invertido em mquinas de outra ordem de bytes
+
+/** \struct traco_cabecalho traco.h "traco.h"
+ *   \brief Incio do arquivo de trao, 32 bytes
+ */
+typedef struct traco_cabecalho {
+    char magica[8];             ///< TRACO_MAGICA
+    uint32_t versao;            ///< TRACO_VERSAO
+    uint32_t ordem;             ///< TRACO_ORDEM
+    uint32_t numTarefas;        ///< Tarefas na tabela que segue o cabealho
+    uint32_t tamanhoEvento;     ///< sizeof(evento_t)
+    uint64_t horizonte;         ///< Escala de tempo do diagrama: fim do intervalo a simular
+} traco_cabecalho_t;
+
+/** \struct traco_tarefa traco.h "traco.h"
+ *   \brief Parmetros de uma tarefa no trao, 40 bytes
+ */
+typedef struct traco_tarefa {
+    uint32_t id;                ///< Identificador da tarefa
+    uint32_t reservado;         ///< Sempre 0, mantm os campos de 64 bits alinhados
+    uint64_t duracao;           ///< C
+    uint64_t periodo;           ///< T
+    uint64_t prazo;             ///< D
+    uint64_t fase;              ///< O
+} traco_tarefa_t;
+
+typedef struct gravadores gravador_t;
+typedef struct tracos traco_t;
+
+/* Instante usado para ordenar e buscar o evento */
+static inline uint64_t traco_chave(const evento_t *evento)
+{
+    return evento->tipo == EVENTO_EXECUCAO ? evento->fim : evento->inicio;
+}
+
+/* Cria o arquivo de trao e grava o cabealho e a tabela - NULL em caso de erro, com errno preenchido */
+gravador_t *cria_gravador(const char *arquivo, struct tabela *tabela, uint64_t horizonte);
+
+/* Acrescenta um evento ao trao */
+void gravador_evento(gravador_t *gravador, const evento_t *evento);
+
+/* Grava o EVENTO_FIM com o ltimo instante simulado, fecha o arquivo e libera o gravador
+ * 0 em caso de sucesso, -1 se alguma escrita falhou */
+int fecha_gravador(gravador_t *gravador, uint64_t fim);
+
+/* Mapeia um trao em memria e valida o cabealho - NULL em caso de erro, informado em stderr */
+traco_t *abre_traco(const char *arquivo);
+void fecha_traco(traco_t *traco);
+
+const traco_cabecalho_t *traco_cabecalho(traco_t *traco);
+const traco_tarefa_t *traco_tarefas(traco_t *traco);
+
+/* Eventos do trao, sem o EVENTO_FIM final */
+const evento_t *traco_eventos(traco_t *traco);
+size_t traco_num_eventos(traco_t *traco);
+
+/* ltimo instante simulado */
+uint64_t traco_fim(traco_t *traco);
+
+/* ndice do primeiro evento com traco_chave() >= tempo, ou traco_num_eventos() se no houver - O(log n) */
+size_t traco_busca(traco_t *traco, uint64_t tempo);
+
+#endif // TRACO_H_INCLUDED